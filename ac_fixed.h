@@ -40,8 +40,8 @@
 //  Modified by:    Domi Yan
 //
 //  Notes:
-//   - Compiler support: Works with the Intel i++ compiler. For g++, use the
-//                       original ac_int.h header file.
+//   - Compiler support: Works with the Intel i++ compiler. With g++ or clang
+//                       the portable limb backend of ac_int.h is used.
 */
 
 #ifndef __ALTR_AC_FIXED_H
@@ -95,6 +95,10 @@ namespace ac_private {
   };
   
   // specializations after definition of ac_fixed
+
+  // argument of the ac_fixed constructor that sets it to 0 without a conversion, for the
+  // temporaries of constexpr functions, which cannot be left uninitialized before C++20
+  enum fixed_zero_t { fixed_zero };
 } 
 
 //////////////////////////////////////////////////////////////////////////////
@@ -117,10 +121,10 @@ class ac_fixed : private ac_private::iv<W, S>
 
   typedef ac_private::iv<N, S> Base;
 
-  inline Base &base() { return *this; }
-  inline const Base &base() const { return *this; }
+  __HLS_CONSTEXPR__ Base &base() { return *this; }
+  __HLS_CONSTEXPR__ const Base &base() const { return *this; }
 
-  inline void overflow_adjust(bool underflow, bool overflow) {
+  __HLS_CONSTEXPR__ void overflow_adjust(bool underflow, bool overflow) {
     if(O==AC_WRAP) {
       return;
     } 
@@ -172,7 +176,7 @@ class ac_fixed : private ac_private::iv<W, S>
   // s: SV is signed and negative
   // qb: MSB of EFP is 1
   // r: rest part of EFP without MSB is not 0 
-  inline bool quantization_adjust(bool qb, bool r, bool s) {
+  __HLS_CONSTEXPR__ bool quantization_adjust(bool qb, bool r, bool s) {
     if(Q==AC_TRN){
       return false;
     }
@@ -197,7 +201,31 @@ class ac_fixed : private ac_private::iv<W, S>
     return ac_private::ap_uadd_carry<N>(Base::value, qb, Base::value);
   }
 
-  inline bool is_neg() const { return S && Base::value < 0; }
+  __HLS_CONSTEXPR__ bool is_neg() const { return S && Base::value < 0; }
+
+  // Sets this to (-1)^sign base 2^e, base of at most BW bits, as converted from the exact value.
+  // Only the bits from 2^(I+1) down to 2^-(F+2) are formed, in an ac_fixed<W+4,I+2,true>, with
+  // the lower ones ORed into its lsb. A larger magnitude is clamped to its maximum, which still
+  // saturates, or for AC_WRAP kept modulo 2^(I+1), which still wraps to the same bits.
+  template<int BW>
+  __HLS_CONSTEXPR__ void set_float(bool sign, Ulong base, int e) {
+    const int k = e + (W - I) + 2;
+    const bool big = k > W + 3 ? base != 0 : k + BW > W + 3 && (base >> (W + 3 - k)) != 0;
+    ac_int<W+3,false> x = 0;
+    if (O != AC_WRAP && big) {
+      x = ~x;
+    } else if (k >= 0) {
+      x = ac_int<W+3,false>(base) << k;
+    } else {
+      const int n = -k;
+      x = n >= 64 ? 0 : base >> n;
+      if (n >= 64 ? base != 0 : (base << (64 - n)) != 0)
+        x[0] = 1;
+    }
+    ac_fixed<W+4,I+2,true> t(ac_private::fixed_zero);
+    t.set_slc(0, sign ? ac_int<W+4,true>(-x) : ac_int<W+4,true>(x));
+    *this = t;
+  }
 
 public:
   static const int width = W;
@@ -274,13 +302,16 @@ public:
     };
   };
 
-  ac_fixed(const ac_fixed &op): Base(op) { }
+  __HLS_CONSTEXPR__ ac_fixed(const ac_fixed &op): Base(op) { }
 
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2> friend class ac_fixed;
-  ac_fixed() {}
+  __HLS_CONSTEXPR__ ac_fixed() {}
+private:
+  __HLS_CONSTEXPR__ explicit ac_fixed(ac_private::fixed_zero_t) : Base(0) {}
+public:
 
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  inline ac_fixed (const ac_fixed<W2,I2,S2,Q2,O2> &op) {
+  __HLS_CONSTEXPR__ ac_fixed (const ac_fixed<W2,I2,S2,Q2,O2> &op) : Base(0) {
     enum {N2=W2, F=W-I, F2=W2-I2, QUAN_INC = F2>F && !(Q==AC_TRN || (Q==AC_TRN_ZERO && !S2)) };
     bool carry = false;
 
@@ -311,7 +342,7 @@ public:
      
       bool deleted_bits_zero = S || S2 || !(carry && Base::value == 0); 
       bool deleted_bits_one =  true; 
-      bool neg_src;
+      bool neg_src = false;
 
       //Deal with Outer Overflow
       //          op[F2-F+W-1] 
@@ -361,92 +392,83 @@ public:
   }
   
   template<int W2, bool S2>
-  inline ac_fixed (const ac_int<W2,S2> &op) {
-    ac_fixed<W2,W2,S2> f_op;
+  __HLS_CONSTEXPR__ ac_fixed (const ac_int<W2,S2> &op) : Base(0) {
+    ac_fixed<W2,W2,S2> f_op(ac_private::fixed_zero);
     f_op.base().operator =(op);
     *this = f_op;
   }
 
   template<int W2>
-  typename rt_priv<W2>::shiftl shiftl() const {
+  __HLS_CONSTEXPR__ typename rt_priv<W2>::shiftl shiftl() const {
     typedef typename rt_priv<W2>::shiftl shiftl_t;
-    shiftl_t r;
+    shiftl_t r(ac_private::fixed_zero);
     Base::template const_shift_l<shiftl_t::N, S, W2>(r);
     return r;
   }
 
   template<int W2, bool S2>
-  inline void set_op (const ac_int<W2,S2> &op, bool b) {
+  __HLS_CONSTEXPR__ void set_op (const ac_int<W2,S2> &op, bool b) {
     Base::value = b ? -op.value : op.value;
   }
   
-  inline void set_op_unsigned(const ac_private::ap_uint<OP_W> op){
+  __HLS_CONSTEXPR__ void set_op_unsigned(const ac_private::ap_uint<OP_W> op){
     Base::value = op;
   }
 
-  inline void set_op_signed(const ac_private::ap_int<OP_W> op){
+  __HLS_CONSTEXPR__ void set_op_signed(const ac_private::ap_int<OP_W> op){
     Base::value = op;
   }
 
-  ac_private::ap_int<OP_W> get_op_signed(){
+  __HLS_CONSTEXPR__ ac_private::ap_int<OP_W> get_op_signed(){
     ac_private::ap_int<OP_W> t = Base::value;
     return t;
   }
 
-  ac_private::ap_uint<OP_W> get_op_unsigned(){
+  __HLS_CONSTEXPR__ ac_private::ap_uint<OP_W> get_op_unsigned(){
     ac_private::ap_uint<OP_W> t = Base::value;
     return t;
   }
 
-  Ulong get_op_in_u64(){
+  __HLS_CONSTEXPR__ Ulong get_op_in_u64(){
     ac_int<W, S> op = 0;
     op.value = Base::value;
     return op.to_uint64();
   }
 
-  inline ac_fixed( bool b ) { *this = (ac_int<1,false>) b; }
-  inline ac_fixed( char b ) { *this = (ac_int<8,true>) b; }
-  inline ac_fixed( signed char b ) { *this = (ac_int<8,true>) b; }
-  inline ac_fixed( unsigned char b ) { *this = (ac_int<8,false>) b; }
-  inline ac_fixed( signed short b ) { *this = (ac_int<16,true>) b; }
-  inline ac_fixed( unsigned short b ) { *this = (ac_int<16,false>) b; }
-  inline ac_fixed( signed int b ) { *this = (ac_int<32,true>) b; }
-  inline ac_fixed( unsigned int b ) { *this = (ac_int<32,false>) b; }
-  inline ac_fixed( signed long b ) { *this = (ac_int<ac_private::long_w,true>) b; }
-  inline ac_fixed( unsigned long b ) { *this = (ac_int<ac_private::long_w,false>) b; }
-  inline ac_fixed( Slong b ) { *this = (ac_int<64,true>) b; }
-  inline ac_fixed( Ulong b ) { *this = (ac_int<64,false>) b; }
-
-  inline ac_fixed( float d ) {
-    unsigned s = *(int *)(&d);
-    bool sign = (bool)((s >> 31) & 1);
-    unsigned biased_exponent = unsigned((s >> __HLS_AC_FRAC_BITS_SINGLE) & 0xFF); // 8 bits
-    unsigned base = (s & ((0X1L << __HLS_AC_FRAC_BITS_SINGLE) - 1)) | (0X1L << __HLS_AC_FRAC_BITS_SINGLE); //24 bits
-    ac_int<__HLS_AC_W_SINGLE, true> t = base;
-    ac_int<__HLS_AC_W_SINGLE, true> m = t << biased_exponent;
-    __hls_ac_ret_single f_op;
-    f_op.set_op(m, sign);
-    __hls_ac_ret_single f_op2(f_op);
-    *this = f_op2;
-  }
-
-  inline ac_fixed( double d ) {
-    Ulong s = *(Ulong *)(&d);
-    bool sign = (bool)((s >> 63) & 1);
-    Ulong biased_exponent = Ulong((s >> __HLS_AC_FRAC_BITS_DOUBLE) & 0x7FFLL); // 11 bits
-    Ulong base = (s & ((0X1LL << __HLS_AC_FRAC_BITS_DOUBLE) - 1LL)) | (0X1LL << __HLS_AC_FRAC_BITS_DOUBLE); //53 bits
-    ac_int<__HLS_AC_W_DOUBLE, true> t = base;
-    ac_int<__HLS_AC_W_DOUBLE, true> m = t << biased_exponent;
-    __hls_ac_ret_double f_op;
-    f_op.set_op(m, sign);
-    __hls_ac_ret_double f_op2(f_op);
-    *this = f_op2;
+  __HLS_CONSTEXPR__ ac_fixed( bool b ) : Base(0) { *this = (ac_int<1,false>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( char b ) : Base(0) { *this = (ac_int<8,true>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( signed char b ) : Base(0) { *this = (ac_int<8,true>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( unsigned char b ) : Base(0) { *this = (ac_int<8,false>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( signed short b ) : Base(0) { *this = (ac_int<16,true>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( unsigned short b ) : Base(0) { *this = (ac_int<16,false>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( signed int b ) : Base(0) { *this = (ac_int<32,true>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( unsigned int b ) : Base(0) { *this = (ac_int<32,false>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( signed long b ) : Base(0) { *this = (ac_int<ac_private::long_w,true>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( unsigned long b ) : Base(0) { *this = (ac_int<ac_private::long_w,false>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( Slong b ) : Base(0) { *this = (ac_int<64,true>) b; }
+  __HLS_CONSTEXPR__ ac_fixed( Ulong b ) : Base(0) { *this = (ac_int<64,false>) b; }
+
+  __HLS_CONSTEXPR__ ac_fixed( float d ) : Base(0) {
+    const unsigned s = AC_BIT_CAST(unsigned, d);
+    const int biased_exponent = (int) ((s >> __HLS_AC_FRAC_BITS_SINGLE) & 0xFF); // 8 bits
+    const unsigned frac = s & ((1u << __HLS_AC_FRAC_BITS_SINGLE) - 1);
+    // zero and subnormals have no hidden bit and the exponent of the smallest normal
+    set_float<__HLS_AC_FRAC_BITS_SINGLE + 1>((s >> 31) & 1, biased_exponent ? frac | 1u << __HLS_AC_FRAC_BITS_SINGLE : frac,
+                                             (biased_exponent ? biased_exponent : 1) - __HLS_AC_F_SINGLE);
+  }
+
+  __HLS_CONSTEXPR__ ac_fixed( double d ) : Base(0) {
+    const Ulong s = AC_BIT_CAST(Ulong, d);
+    const int biased_exponent = (int) ((s >> __HLS_AC_FRAC_BITS_DOUBLE) & 0x7FF); // 11 bits
+    const Ulong frac = s & (((Ulong) 1 << __HLS_AC_FRAC_BITS_DOUBLE) - 1);
+    set_float<__HLS_AC_FRAC_BITS_DOUBLE + 1>((s >> 63) & 1, biased_exponent ? frac | (Ulong) 1 << __HLS_AC_FRAC_BITS_DOUBLE : frac,
+                                             (biased_exponent ? biased_exponent : 1) - __HLS_AC_F_DOUBLE);
   }
 
   template<ac_special_val V>
-  inline ac_fixed &set_val() {
+  __HLS_CONSTEXPR__ ac_fixed &set_val() {
     if(V == AC_VAL_DC) {
-      ac_fixed r;
+      ac_fixed r(ac_private::fixed_zero);
       Base::operator =(r);
     }
     else if(V == AC_VAL_0 || V == AC_VAL_MIN || V == AC_VAL_QUANTUM) {
@@ -480,18 +502,18 @@ public:
 
   // Explicit conversion functions to ac_int that captures all integer bits (bits are truncated)
   // Change from ref: smallest bits is 2!!!
-  inline ac_int<AC_MAX(I,2),S> to_ac_int() const { return ((ac_fixed<AC_MAX(I,2),AC_MAX(I,2),S>) *this).template slc<AC_MAX(I,2)>(0); }
+  __HLS_CONSTEXPR__ ac_int<AC_MAX(I,2),S> to_ac_int() const { return ((ac_fixed<AC_MAX(I,2),AC_MAX(I,2),S>) *this).template slc<AC_MAX(I,2)>(0); }
 
   // Explicit conversion functions to C built-in types -------------
-  inline int to_int() const { return ((I-W) >= 32) ? 0 : (signed int) to_ac_int(); } 
-  inline unsigned to_uint() const { return ((I-W) >= 32) ? 0 : (unsigned int) to_ac_int(); }
-  inline long to_long() const { return ((I-W) >= ac_private::long_w) ? 0 : (signed long) to_ac_int(); } 
-  inline unsigned long to_ulong() const { return ((I-W) >= ac_private::long_w) ? 0 : (unsigned long) to_ac_int(); } 
-  inline Slong to_int64() const { return ((I-W) >= 64) ? 0 : (Slong) to_ac_int(); } 
-  inline Ulong to_uint64() const { return ((I-W) >= 64) ? 0 : (Ulong) to_ac_int(); } 
-  inline double to_double() const { return ac_private::ldexpr<I-W>(Base::to_double()); } 
+  __HLS_CONSTEXPR__ int to_int() const { return ((I-W) >= 32) ? 0 : (signed int) to_ac_int(); } 
+  __HLS_CONSTEXPR__ unsigned to_uint() const { return ((I-W) >= 32) ? 0 : (unsigned int) to_ac_int(); }
+  __HLS_CONSTEXPR__ long to_long() const { return ((I-W) >= ac_private::long_w) ? 0 : (signed long) to_ac_int(); } 
+  __HLS_CONSTEXPR__ unsigned long to_ulong() const { return ((I-W) >= ac_private::long_w) ? 0 : (unsigned long) to_ac_int(); } 
+  __HLS_CONSTEXPR__ Slong to_int64() const { return ((I-W) >= 64) ? 0 : (Slong) to_ac_int(); } 
+  __HLS_CONSTEXPR__ Ulong to_uint64() const { return ((I-W) >= 64) ? 0 : (Ulong) to_ac_int(); } 
+  __HLS_CONSTEXPR__ double to_double() const { return ac_private::ldexpr<I-W>(Base::to_double()); } 
 
-  inline int length() const { return W; }
+  __HLS_CONSTEXPR__ int length() const { return W; }
 
   inline std::string to_string(ac_base_mode base_rep, bool sign_mag = false) const {
     ac_private::ap_uint<5> base = 10;
@@ -595,15 +617,15 @@ public:
 
   // Arithmetic : Binary ----------------------------------------------------
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  typename rt<W2,I2,S2>::mult operator *( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
-    typename rt<W2,I2,S2>::mult r;
+  __HLS_CONSTEXPR__ typename rt<W2,I2,S2>::mult operator *( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+    typename rt<W2,I2,S2>::mult r(ac_private::fixed_zero);
     Base::mult(op2, r);
     return r;
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  typename rt<W2,I2,S2>::plus operator +( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ typename rt<W2,I2,S2>::plus operator +( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
-    typename rt<W2,I2,S2>::plus r;
+    typename rt<W2,I2,S2>::plus r(ac_private::fixed_zero);
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
       Base::add(op2, r);
@@ -615,9 +637,9 @@ public:
     return r;
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  typename rt<W2,I2,S2>::minus operator -( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ typename rt<W2,I2,S2>::minus operator -( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
-    typename rt<W2,I2,S2>::minus r;
+    typename rt<W2,I2,S2>::minus r(ac_private::fixed_zero);
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
       Base::sub(op2, r);
@@ -632,8 +654,8 @@ public:
 #pragma GCC diagnostic ignored "-Wenum-compare"
 #endif
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  typename rt<W2,I2,S2>::div operator /( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
-    typename rt<W2,I2,S2>::div r;
+  __HLS_CONSTEXPR__ typename rt<W2,I2,S2>::div operator /( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+    typename rt<W2,I2,S2>::div r(ac_private::fixed_zero);
     enum { Num_w = W+AC_MAX(W2-I2,0), Num_i = I };
     ac_fixed<Num_w, Num_i, S> t = *this;
     t.template div<W2, S2, W+AC_MAX(W2-I2,0)+S2, S||S2>(op2, r);
@@ -644,85 +666,85 @@ public:
 #endif
   // Arithmetic assign  ------------------------------------------------------
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  ac_fixed &operator *=( const ac_fixed<W2,I2,S2,Q2,O2> &op2) {
+  __HLS_CONSTEXPR__ ac_fixed &operator *=( const ac_fixed<W2,I2,S2,Q2,O2> &op2) {
     *this = this->operator *(op2);
     return *this;
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  ac_fixed &operator +=( const ac_fixed<W2,I2,S2,Q2,O2> &op2) {
+  __HLS_CONSTEXPR__ ac_fixed &operator +=( const ac_fixed<W2,I2,S2,Q2,O2> &op2) {
     *this = this->operator +(op2);
     return *this;
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  ac_fixed &operator -=( const ac_fixed<W2,I2,S2,Q2,O2> &op2) {
+  __HLS_CONSTEXPR__ ac_fixed &operator -=( const ac_fixed<W2,I2,S2,Q2,O2> &op2) {
     *this = this->operator -(op2);
     return *this;
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  ac_fixed &operator /=( const ac_fixed<W2,I2,S2,Q2,O2> &op2) {
+  __HLS_CONSTEXPR__ ac_fixed &operator /=( const ac_fixed<W2,I2,S2,Q2,O2> &op2) {
     *this = this->operator /(op2);
     return *this;
   }
   // increment/decrement by quantum (smallest difference that can be represented)
   // Arithmetic prefix increment, decrement ---------------------------------
-  ac_fixed &operator ++() {
-    ac_fixed<1,I-W+1,false> q;
+  __HLS_CONSTEXPR__ ac_fixed &operator ++() {
+    ac_fixed<1,I-W+1,false> q(ac_private::fixed_zero);
     q.template set_val<AC_VAL_QUANTUM>();
     operator += (q);
     return *this;
   }
-  ac_fixed &operator --() {
-    ac_fixed<1,I-W+1,false> q;
+  __HLS_CONSTEXPR__ ac_fixed &operator --() {
+    ac_fixed<1,I-W+1,false> q(ac_private::fixed_zero);
     q.template set_val<AC_VAL_QUANTUM>();
     operator -= (q);
     return *this;
   }
   // Arithmetic postfix increment, decrement ---------------------------------
-  const ac_fixed operator ++(int) {
+  __HLS_CONSTEXPR__ const ac_fixed operator ++(int) {
     ac_fixed t = *this;
-    ac_fixed<1,I-W+1,false> q;
+    ac_fixed<1,I-W+1,false> q(ac_private::fixed_zero);
     q.template set_val<AC_VAL_QUANTUM>();
     operator += (q); 
     return t;
   }
-  const ac_fixed operator --(int) {
+  __HLS_CONSTEXPR__ const ac_fixed operator --(int) {
     ac_fixed t = *this;
-    ac_fixed<1,I-W+1,false> q;
+    ac_fixed<1,I-W+1,false> q(ac_private::fixed_zero);
     q.template set_val<AC_VAL_QUANTUM>();
     operator -= (q);
     return t;
   }
   // Arithmetic Unary --------------------------------------------------------
-  ac_fixed operator +() {
+  __HLS_CONSTEXPR__ ac_fixed operator +() {
     return *this;
   }
-  typename rt_unary::neg operator -() const {
-    typename rt_unary::neg r;
+  __HLS_CONSTEXPR__ typename rt_unary::neg operator -() const {
+    typename rt_unary::neg r(ac_private::fixed_zero);
     Base::neg(r);
     return r;
   }
   // ! ------------------------------------------------------------------------
-  bool operator ! () const {
+  __HLS_CONSTEXPR__ bool operator ! () const {
     return Base::equal_zero(); 
   }
 
   // Bitwise (arithmetic) unary: complement  -----------------------------
-  ac_fixed<W+!S, I+!S, true> operator ~() const {
-    ac_fixed<W+!S, I+!S, true> r;
+  __HLS_CONSTEXPR__ ac_fixed<W+!S, I+!S, true> operator ~() const {
+    ac_fixed<W+!S, I+!S, true> r(ac_private::fixed_zero);
     Base::bitwise_complement(r);
     return r;
   }
   // Bitwise (not arithmetic) bit complement  -----------------------------
-  ac_fixed<W, I, false> bit_complement() const {
-    ac_fixed<W, I, false> r;
+  __HLS_CONSTEXPR__ ac_fixed<W, I, false> bit_complement() const {
+    ac_fixed<W, I, false> r(ac_private::fixed_zero);
     Base::bitwise_complement(r);
     return r;
   }
   // Bitwise (not arithmetic): and, or, xor ----------------------------------
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  typename rt<W2,I2,S2>::logic operator &( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ typename rt<W2,I2,S2>::logic operator &( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
-    typename rt<W2,I2,S2>::logic r;
+    typename rt<W2,I2,S2>::logic r(ac_private::fixed_zero);
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
       Base::bitwise_and(op2, r);
@@ -733,9 +755,9 @@ public:
     return r;
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  typename rt<W2,I2,S2>::logic operator |( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ typename rt<W2,I2,S2>::logic operator |( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
-    typename rt<W2,I2,S2>::logic r;
+    typename rt<W2,I2,S2>::logic r(ac_private::fixed_zero);
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
       Base::bitwise_or(op2, r);
@@ -746,9 +768,9 @@ public:
     return r;
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  typename rt<W2,I2,S2>::logic operator ^( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ typename rt<W2,I2,S2>::logic operator ^( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
-    typename rt<W2,I2,S2>::logic r;
+    typename rt<W2,I2,S2>::logic r(ac_private::fixed_zero);
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
       Base::bitwise_xor(op2, r);
@@ -761,86 +783,86 @@ public:
   // Bitwise assign (not arithmetic): and, or, xor ----------------------------
   
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  ac_fixed &operator &= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2 ) {
+  __HLS_CONSTEXPR__ ac_fixed &operator &= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2 ) {
     *this = this->operator &(op2);
     return *this;
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  ac_fixed &operator |= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2 ) {
+  __HLS_CONSTEXPR__ ac_fixed &operator |= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2 ) {
     *this = this->operator |(op2);
     return *this;
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  ac_fixed &operator ^= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2 ) {
+  __HLS_CONSTEXPR__ ac_fixed &operator ^= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2 ) {
     *this = this->operator ^(op2);
     return *this;
   }
   
   // Shift (result constrained by left operand) -------------------------------
   template<int W2>
-  ac_fixed operator << ( const ac_int<W2,true> &op2 ) const {
+  __HLS_CONSTEXPR__ ac_fixed operator << ( const ac_int<W2,true> &op2 ) const {
     // currently not written to overflow or quantize (neg shift)
-    ac_fixed r;
+    ac_fixed r(ac_private::fixed_zero);
     Base::shift_l2(op2.to_int(), r);
     return r;
   }
   template<int W2>
-  ac_fixed operator << ( const ac_int<W2,false> &op2 ) const {
+  __HLS_CONSTEXPR__ ac_fixed operator << ( const ac_int<W2,false> &op2 ) const {
     // currently not written to overflow
-    ac_fixed r;
+    ac_fixed r(ac_private::fixed_zero);
     Base::shift_l(op2.to_uint(), r);
     return r;
   }
   template<int W2>
-  ac_fixed operator >> ( const ac_int<W2,true> &op2 ) const {
+  __HLS_CONSTEXPR__ ac_fixed operator >> ( const ac_int<W2,true> &op2 ) const {
     // currently not written to quantize or overflow (neg shift)
-    ac_fixed r;
+    ac_fixed r(ac_private::fixed_zero);
     Base::shift_r2(op2.to_int(), r);
     return r;
   }
   template<int W2>
-  ac_fixed operator >> ( const ac_int<W2,false> &op2 ) const {
+  __HLS_CONSTEXPR__ ac_fixed operator >> ( const ac_int<W2,false> &op2 ) const {
     // currently not written to quantize 
-    ac_fixed r;
+    ac_fixed r(ac_private::fixed_zero);
     Base::shift_r(op2.to_uint(), r);
     return r;
   }
   // Shift assign ------------------------------------------------------------
   template<int W2>
-  ac_fixed operator <<= ( const ac_int<W2,true> &op2 ) {
+  __HLS_CONSTEXPR__ ac_fixed operator <<= ( const ac_int<W2,true> &op2 ) {
     // currently not written to overflow or quantize (neg shift)
-    Base r;
+    Base r = 0;
     Base::shift_l2(op2.to_int(), r);
     Base::operator=(r);
     return *this;
   }
   template<int W2>
-  ac_fixed operator <<= ( const ac_int<W2,false> &op2 ) {
+  __HLS_CONSTEXPR__ ac_fixed operator <<= ( const ac_int<W2,false> &op2 ) {
     // currently not written to overflow
-    Base r;
+    Base r = 0;
     Base::shift_l(op2.to_uint(), r);
     Base::operator=(r);
     return *this;
   }
   template<int W2>
-  ac_fixed operator >>= ( const ac_int<W2,true> &op2 ) {
+  __HLS_CONSTEXPR__ ac_fixed operator >>= ( const ac_int<W2,true> &op2 ) {
     // currently not written to quantize or overflow (neg shift)
-    Base r;
+    Base r = 0;
     Base::shift_r2(op2.to_int(), r);
     Base::operator=(r);
     return *this;
   }
   template<int W2>
-  ac_fixed operator >>= ( const ac_int<W2,false> &op2 ) {
+  __HLS_CONSTEXPR__ ac_fixed operator >>= ( const ac_int<W2,false> &op2 ) {
     // currently not written to quantize 
-    Base r;
+    Base r = 0;
     Base::shift_r(op2.to_uint(), r);
     Base::operator=(r);
     return *this;
   }
   // Relational ---------------------------------------------------------------
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  bool operator == ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ bool operator == ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
@@ -851,7 +873,7 @@ public:
       return shiftl<shift_v>().equal(op2);
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  bool operator != ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ bool operator != ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
@@ -862,7 +884,7 @@ public:
       return ! shiftl<shift_v>().equal(op2);
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  bool operator < ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ bool operator < ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
@@ -873,7 +895,7 @@ public:
       return shiftl<shift_v>().less_than(op2);
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  bool operator >= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ bool operator >= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
@@ -884,7 +906,7 @@ public:
       return ! shiftl<shift_v>().less_than(op2);
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  bool operator > ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ bool operator > ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
@@ -895,7 +917,7 @@ public:
       return shiftl<shift_v>().greater_than(op2); 
   }
   template<int W2, int I2, bool S2, ac_q_mode Q2, ac_o_mode O2>
-  bool operator <= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
+  __HLS_CONSTEXPR__ bool operator <= ( const ac_fixed<W2,I2,S2,Q2,O2> &op2) const {
     enum { F=W-I, F2=W2-I2 };
     const int shift_v = AC_MAX(F - F2, F2 - F);
     if(F == F2)
@@ -953,7 +975,7 @@ public:
 
   // Bit and Slice Select -----------------------------------------------------
   template<int WS, int WX, bool SX>
-  inline ac_int<WS,S> slc(const ac_int<WX,SX> &index) const {
+  __HLS_CONSTEXPR__ ac_int<WS,S> slc(const ac_int<WX,SX> &index) const {
     ac_int<W, S> op = 0;
     AC_ASSERT(index >= 0, "Attempting to read slc with negative indices");
     ac_int<WX-SX, false> uindex = index;
@@ -963,7 +985,7 @@ public:
   }
 
   template<int WS>
-  inline ac_int<WS,S> slc(signed index) const {
+  __HLS_CONSTEXPR__ ac_int<WS,S> slc(signed index) const {
     ac_int<W, S> op = 0;
     AC_ASSERT(index >= 0, "Attempting to read slc with negative indices");
     unsigned uindex = index & ((unsigned)~0 >> 1);
@@ -973,7 +995,7 @@ public:
   }
 
   template<int WS>
-  inline ac_int<WS,S> slc(unsigned uindex) const {
+  __HLS_CONSTEXPR__ ac_int<WS,S> slc(unsigned uindex) const {
     ac_int<W, S> op = 0;
     Base::shift_r(uindex, op);
     ac_int<WS,S> r = op;
@@ -981,7 +1003,7 @@ public:
   }
 
   template<int W2, bool S2, int WX, bool SX>
-  inline ac_fixed &set_slc(const ac_int<WX,SX> lsb, const ac_int<W2,S2> &slc) {
+  __HLS_CONSTEXPR__ ac_fixed &set_slc(const ac_int<WX,SX> lsb, const ac_int<W2,S2> &slc) {
     AC_ASSERT(lsb.to_int() + W2 <= W && lsb.to_int() >= 0, "Out of bounds set_slc");
     ac_int<WX-SX, false> ulsb = lsb;
     Base::set_slc(ulsb.to_uint(), W2, (ac_int<W2,false>) slc);
@@ -989,7 +1011,7 @@ public:
   }
 
   template<int W2, bool S2>
-  inline ac_fixed &set_slc(signed lsb, const ac_int<W2,S2> &slc) {
+  __HLS_CONSTEXPR__ ac_fixed &set_slc(signed lsb, const ac_int<W2,S2> &slc) {
     AC_ASSERT(lsb + W2 <= W && lsb >= 0, "Out of bounds set_slc");
     unsigned ulsb = lsb & ((unsigned)~0 >> 1);
     Base::set_slc(ulsb, W2, (ac_int<W2,false>) slc);
@@ -998,7 +1020,7 @@ public:
   }
 
   template<int W2, bool S2>
-  inline ac_fixed &set_slc(unsigned ulsb, const ac_int<W2,S2> &slc) {
+  __HLS_CONSTEXPR__ ac_fixed &set_slc(unsigned ulsb, const ac_int<W2,S2> &slc) {
     AC_ASSERT(ulsb + W2 <= W, "Out of bounds set_slc");
     Base::set_slc(ulsb, W2, (ac_int<W2,false>) slc);
     return *this;
@@ -1008,11 +1030,11 @@ public:
     ac_fixed &d_bv;
     unsigned d_index;
   public:
-    ac_bitref( ac_fixed *bv, unsigned index=0 ) : d_bv(*bv), d_index(index) {}\
+    __HLS_CONSTEXPR__ ac_bitref( ac_fixed *bv, unsigned index=0 ) : d_bv(*bv), d_index(index) {}\
 
-    operator bool () const { return (d_index < W) ? (bool)(d_bv.value >> (d_index) & 1) : 0; }
+    __HLS_CONSTEXPR__ operator bool () const { return (d_index < W) ? (bool)(d_bv.value >> (d_index) & 1) : 0; }
 
-    inline ac_bitref operator = ( int val ) {
+    __HLS_CONSTEXPR__ ac_bitref operator = ( int val ) {
       // lsb of int (val&1) is written to bit
       /*
       if(d_index < W) {
@@ -1036,20 +1058,20 @@ public:
     }
 
     template<int W2, bool S2>
-    inline ac_bitref operator = ( const ac_int<W2,S2> &val ) {
+    __HLS_CONSTEXPR__ ac_bitref operator = ( const ac_int<W2,S2> &val ) {
       return operator =(val.to_int());
     }
-    inline ac_bitref operator = ( const ac_bitref &val ) {
+    __HLS_CONSTEXPR__ ac_bitref operator = ( const ac_bitref &val ) {
       return operator =((int) (bool) val);
     }
   };
                                                                                                              
-  ac_bitref operator [] ( unsigned int uindex) {
+  __HLS_CONSTEXPR__ ac_bitref operator [] ( unsigned int uindex) {
     AC_ASSERT(uindex < W, "Attempting to read bit beyond MSB");
     ac_bitref bvh( this, uindex );
     return bvh;
   }
-  ac_bitref operator [] ( int index) {
+  __HLS_CONSTEXPR__ ac_bitref operator [] ( int index) {
     AC_ASSERT(index >= 0, "Attempting to read bit with negative index");
     AC_ASSERT(index < W, "Attempting to read bit beyond MSB");
     unsigned uindex = index & ((unsigned)~0 >> 1);
@@ -1057,7 +1079,7 @@ public:
     return bvh;
   }
   template<int W2, bool S2>
-  ac_bitref operator [] ( const ac_int<W2,S2> &index) {
+  __HLS_CONSTEXPR__ ac_bitref operator [] ( const ac_int<W2,S2> &index) {
     AC_ASSERT(index >= 0, "Attempting to read bit with negative index");
     AC_ASSERT(index < W, "Attempting to read bit beyond MSB");
     ac_int<W2-S2,false> uindex = index;
@@ -1065,18 +1087,18 @@ public:
     return bvh;
   }
 
-  bool operator [] ( unsigned int uindex) const {
+  __HLS_CONSTEXPR__ bool operator [] ( unsigned int uindex) const {
     AC_ASSERT(uindex < W, "Attempting to read bit beyond MSB");
     return (uindex < W) ? (bool)(Base::value >> uindex & 1) : 0;
   }
-  bool operator [] ( int index) const {
+  __HLS_CONSTEXPR__ bool operator [] ( int index) const {
     AC_ASSERT(index >= 0, "Attempting to read bit with negative index");
     AC_ASSERT(index < W, "Attempting to read bit beyond MSB");
     unsigned uindex = index & ((unsigned)~0 >> 1);
     return (uindex < W) ? (bool)(Base::value >> uindex & 1) : 0;
   }
   template<int W2, bool S2>
-  bool operator [] ( const ac_int<W2,S2> &index) const {
+  __HLS_CONSTEXPR__ bool operator [] ( const ac_int<W2,S2> &index) const {
     AC_ASSERT(index >= 0, "Attempting to read bit with negative index");
     AC_ASSERT(index < W, "Attempting to read bit beyond MSB");
     ac_int<W2-S2,false> uindex = index;
@@ -1129,6 +1151,68 @@ public:
     x.bit_fill(ivec, bigendian);
     set_slc(0, x);
   }
+  // Parses a number with an optional leading '-' and an optional fraction after '.', digits
+  // in base_rep (e.g. -12.375, or ff.8 in AC_HEX), from the start of [first, last) and returns
+  // the end of it like std::from_chars, or first if there are no digits. The value is the
+  // exact number quantized with Q and O, as if it had been assigned from a wider ac_fixed.
+  inline const char *from_chars(const char *first, const char *last, ac_base_mode base_rep = AC_DEC) {
+    // the number is formed exactly in t with F + 1 fraction bits and a sticky bit for the
+    // rest, the first F + 1 digits of the fraction decide the F + 1 bits
+    enum { F = AC_MAX(W - I, 0), IW = AC_MAX(I, 1) + 1, KD = F + 1 };
+    const char *p = first;
+    const bool neg = p != last && *p == '-';
+    p += neg;
+    if (p != last && *p == '-')
+      return first;
+    bool overflow = false;
+    ac_int<IW, false> ip = 0;
+    const char *e = ip.from_chars(p, last, base_rep, overflow);
+    bool digits = e != p;
+    if (overflow && O != AC_WRAP)
+      ip = ~ac_int<IW, false>(0);
+    ac_int<F + 2, false> fb = 0;
+    if (e != last && *e == '.' && (e + 1 == last || e[1] != '-')) {
+      const char *f = e + 1;
+      ac_int<4 * KD, false> fd = 0;
+      e = fd.from_chars(f, last - f > KD ? f + KD : last, base_rep);
+      const int k = e - f;
+      ac_int<1, false> rest = 0;
+      bool rest_overflow = false;
+      if (k == KD && e != last && *e != '-')
+        e = rest.from_chars(e, last, base_rep, rest_overflow);
+      if (k > 0) {
+        digits = true;
+        ac_int<4 * KD + F + 1, false> num = fd;
+        num <<= F + 1;
+        ac_int<4 * KD + 1, false> den = 1;
+        for (int i = 0; i < k; i++)
+          den = den * ac_int<5, false>(base_rep);
+        const ac_int<F + 1, false> q = num / den;
+        fb = q;
+        fb <<= 1;
+        // the remainder in the width of num, as % would first cut num down to that of den
+        fb[0] = num % ac_int<4 * KD + F + 1, false>(den) != 0 || rest != 0 || rest_overflow;
+      }
+    }
+    if (!digits)
+      return first;
+    ac_int<IW + F + 3, true> raw = 0;
+    raw.set_slc(F + 2, ip);
+    raw.set_slc(0, fb);
+    if (neg)
+      raw = -raw;
+    ac_fixed<IW + F + 3, IW + 1, true> t(ac_private::fixed_zero);
+    t.set_slc(0, raw);
+    *this = t;
+    return e;
+  }
+  // Reads and writes the bits as (W + 7) / 8 bytes, see ac_int::from_bytes
+  inline void from_bytes(const unsigned char *p, bool bigendian = false) {
+    Base::from_bytes(p, bigendian);
+  }
+  inline void to_bytes(unsigned char *p, bool bigendian = false) const {
+    Base::to_bytes(p, bigendian);
+  }
 };
 
 namespace ac {
@@ -1207,50 +1291,50 @@ namespace ac_private {
 //this use ap_int<1>
 //template<> inline ac_fixed<1,1,true,AC_TRN,AC_WRAP>::ac_fixed( bool b ) { value = b ? -1 : 0; }
 
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( bool b ) { value = b; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) { value = b&1; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) { value = b&1; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( signed short b ) { value = b&1; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned short b ) { value = b&1; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( signed int b ) { value = b&1; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned int b ) { value = b&1; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( signed long b ) { value = b&1; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned long b ) { value = b&1; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) { value = (int) b&1; }
-template<> inline ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) { value = (int) b&1; }
-
-template<> inline ac_fixed<8,8,true,AC_TRN,AC_WRAP>::ac_fixed( bool b ) { value = b; }
-template<> inline ac_fixed<8,8,false,AC_TRN,AC_WRAP>::ac_fixed( bool b ) { value = b; }
-template<> inline ac_fixed<8,8,true,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) { value = b; }
-template<> inline ac_fixed<8,8,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) { value = b; }
-template<> inline ac_fixed<8,8,true,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) { value = (signed char) b; }
-template<> inline ac_fixed<8,8,false,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) { value = (unsigned char) b; }
-
-template<> inline ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( bool b ) { value = b; }
-template<> inline ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( bool b ) { value = b; }
-template<> inline ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) { value = b; }
-template<> inline ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) { value = b; }
-template<> inline ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) { value = b; }
-template<> inline ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) { value = (unsigned short) b; }
-template<> inline ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( signed short b ) { value = b; }
-template<> inline ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned short b ) { value = b; }
-template<> inline ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( unsigned short b ) { value = (signed short) b; }
-template<> inline ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( signed short b ) { value = (unsigned short) b; }
-
-template<> inline ac_fixed<32,32,true,AC_TRN,AC_WRAP>::ac_fixed( signed int b ) { value = b; }
-template<> inline ac_fixed<32,32,true,AC_TRN,AC_WRAP>::ac_fixed( unsigned int b ) { value = b; }
-template<> inline ac_fixed<32,32,false,AC_TRN,AC_WRAP>::ac_fixed( signed int b ) { value = b; }
-template<> inline ac_fixed<32,32,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned int b ) { value = b; }
-
-template<> inline ac_fixed<32,32,true,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) { value = (int) b; }
-template<> inline ac_fixed<32,32,true,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) { value = (int) b; }
-template<> inline ac_fixed<32,32,false,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) { value = (int) b; }
-template<> inline ac_fixed<32,32,false,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) { value = (int) b; }
-
-template<> inline ac_fixed<64,64,true,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) { value = (int) b; }
-template<> inline ac_fixed<64,64,true,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) { value = (int) b; }
-template<> inline ac_fixed<64,64,false,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) { value = (int) b; }
-template<> inline ac_fixed<64,64,false,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) { value = (int) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( bool b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) : Base(0) { value = b&1; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) : Base(0) { value = b&1; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( signed short b ) : Base(0) { value = b&1; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned short b ) : Base(0) { value = b&1; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( signed int b ) : Base(0) { value = b&1; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned int b ) : Base(0) { value = b&1; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( signed long b ) : Base(0) { value = b&1; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned long b ) : Base(0) { value = b&1; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) : Base(0) { value = (int) b&1; }
+template<> __HLS_CONSTEXPR__ ac_fixed<1,1,false,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) : Base(0) { value = (int) b&1; }
+
+template<> __HLS_CONSTEXPR__ ac_fixed<8,8,true,AC_TRN,AC_WRAP>::ac_fixed( bool b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<8,8,false,AC_TRN,AC_WRAP>::ac_fixed( bool b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<8,8,true,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<8,8,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<8,8,true,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) : Base(0) { value = (signed char) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<8,8,false,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) : Base(0) { value = (unsigned char) b; }
+
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( bool b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( bool b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( unsigned char b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( signed char b ) : Base(0) { value = (unsigned short) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( signed short b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned short b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,true,AC_TRN,AC_WRAP>::ac_fixed( unsigned short b ) : Base(0) { value = (signed short) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<16,16,false,AC_TRN,AC_WRAP>::ac_fixed( signed short b ) : Base(0) { value = (unsigned short) b; }
+
+template<> __HLS_CONSTEXPR__ ac_fixed<32,32,true,AC_TRN,AC_WRAP>::ac_fixed( signed int b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<32,32,true,AC_TRN,AC_WRAP>::ac_fixed( unsigned int b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<32,32,false,AC_TRN,AC_WRAP>::ac_fixed( signed int b ) : Base(0) { value = b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<32,32,false,AC_TRN,AC_WRAP>::ac_fixed( unsigned int b ) : Base(0) { value = b; }
+
+template<> __HLS_CONSTEXPR__ ac_fixed<32,32,true,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) : Base(0) { value = (int) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<32,32,true,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) : Base(0) { value = (int) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<32,32,false,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) : Base(0) { value = (int) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<32,32,false,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) : Base(0) { value = (int) b; }
+
+template<> __HLS_CONSTEXPR__ ac_fixed<64,64,true,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) : Base(0) { value = (int) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<64,64,true,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) : Base(0) { value = (int) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<64,64,false,AC_TRN,AC_WRAP>::ac_fixed( Slong b ) : Base(0) { value = (int) b; }
+template<> __HLS_CONSTEXPR__ ac_fixed<64,64,false,AC_TRN,AC_WRAP>::ac_fixed( Ulong b ) : Base(0) { value = (int) b; }
 
 
 // Stream --------------------------------------------------------------------
@@ -1266,39 +1350,39 @@ inline std::ostream& operator << (std::ostream &os, const ac_fixed<W,I,S,Q,O> &x
 
 #define FX_BIN_OP_WITH_INT_2I(BIN_OP, C_TYPE, WI, SI, RTYPE)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
-  inline typename ac_fixed<W,I,S>::template rt<WI,WI,SI>::RTYPE operator BIN_OP ( const ac_fixed<W,I,S,Q,O> &op, C_TYPE i_op) {  \
+  __HLS_CONSTEXPR__ inline typename ac_fixed<W,I,S>::template rt<WI,WI,SI>::RTYPE operator BIN_OP ( const ac_fixed<W,I,S,Q,O> &op, C_TYPE i_op) {  \
     return op.operator BIN_OP (ac_int<WI,SI>(i_op));  \
   }
 
 #define FX_BIN_OP_WITH_INT(BIN_OP, C_TYPE, WI, SI, RTYPE)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
-  inline typename ac_fixed<WI,WI,SI>::template rt<W,I,S>::RTYPE operator BIN_OP ( C_TYPE i_op, const ac_fixed<W,I,S,Q,O> &op) {  \
+  __HLS_CONSTEXPR__ inline typename ac_fixed<WI,WI,SI>::template rt<W,I,S>::RTYPE operator BIN_OP ( C_TYPE i_op, const ac_fixed<W,I,S,Q,O> &op) {  \
     return ac_fixed<WI,WI,SI>(i_op).operator BIN_OP (op);  \
   } \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
-  inline typename ac_fixed<W,I,S>::template rt<WI,WI,SI>::RTYPE operator BIN_OP ( const ac_fixed<W,I,S,Q,O> &op, C_TYPE i_op) {  \
+  __HLS_CONSTEXPR__ inline typename ac_fixed<W,I,S>::template rt<WI,WI,SI>::RTYPE operator BIN_OP ( const ac_fixed<W,I,S,Q,O> &op, C_TYPE i_op) {  \
     return op.operator BIN_OP (ac_fixed<WI,WI,SI>(i_op));  \
   }
 
 #define FX_REL_OP_WITH_INT(REL_OP, C_TYPE, W2, S2)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
-  inline bool operator REL_OP ( const ac_fixed<W,I,S,Q,O> &op, C_TYPE op2) {  \
+  __HLS_CONSTEXPR__ inline bool operator REL_OP ( const ac_fixed<W,I,S,Q,O> &op, C_TYPE op2) {  \
     return op.operator REL_OP (ac_fixed<W2,W2,S2>(op2));  \
   }  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
-  inline bool operator REL_OP ( C_TYPE op2, const ac_fixed<W,I,S,Q,O> &op) {  \
+  __HLS_CONSTEXPR__ inline bool operator REL_OP ( C_TYPE op2, const ac_fixed<W,I,S,Q,O> &op) {  \
     return ac_fixed<W2,W2,S2>(op2).operator REL_OP (op);  \
   }
 
 #define FX_ASSIGN_OP_WITH_INT_2(ASSIGN_OP, C_TYPE, W2, S2)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
-  inline ac_fixed<W,I,S,Q,O> &operator ASSIGN_OP ( ac_fixed<W,I,S,Q,O> &op, C_TYPE op2) {  \
+  __HLS_CONSTEXPR__ inline ac_fixed<W,I,S,Q,O> &operator ASSIGN_OP ( ac_fixed<W,I,S,Q,O> &op, C_TYPE op2) {  \
     return op.operator ASSIGN_OP (ac_fixed<W2,W2,S2>(op2));  \
   }
 
 #define FX_ASSIGN_OP_WITH_INT_2I(ASSIGN_OP, C_TYPE, W2, S2)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O> \
-  inline ac_fixed<W,I,S> operator ASSIGN_OP ( ac_fixed<W,I,S,Q,O> &op, C_TYPE op2) {  \
+  __HLS_CONSTEXPR__ inline ac_fixed<W,I,S> operator ASSIGN_OP ( ac_fixed<W,I,S,Q,O> &op, C_TYPE op2) {  \
     return op.operator ASSIGN_OP (ac_int<W2,S2>(op2));  \
   }
 
@@ -1360,13 +1444,13 @@ namespace ac {
 
 #define FX_BIN_OP_WITH_AC_INT_1(BIN_OP, RTYPE)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
-  inline typename ac_fixed<WI,WI,SI>::template rt<W,I,S>::RTYPE operator BIN_OP ( const ac_int<WI,SI> &i_op, const ac_fixed<W,I,S,Q,O> &op) {  \
+  __HLS_CONSTEXPR__ inline typename ac_fixed<WI,WI,SI>::template rt<W,I,S>::RTYPE operator BIN_OP ( const ac_int<WI,SI> &i_op, const ac_fixed<W,I,S,Q,O> &op) {  \
     return ac_fixed<WI,WI,SI>(i_op).operator BIN_OP (op);  \
   }
 
 #define FX_BIN_OP_WITH_AC_INT_2(BIN_OP, RTYPE)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
-  inline typename ac_fixed<W,I,S>::template rt<WI,WI,SI>::RTYPE operator BIN_OP ( const ac_fixed<W,I,S,Q,O> &op, const ac_int<WI,SI> &i_op) {  \
+  __HLS_CONSTEXPR__ inline typename ac_fixed<W,I,S>::template rt<WI,WI,SI>::RTYPE operator BIN_OP ( const ac_fixed<W,I,S,Q,O> &op, const ac_int<WI,SI> &i_op) {  \
     return op.operator BIN_OP (ac_fixed<WI,WI,SI>(i_op));  \
   }
 
@@ -1376,21 +1460,21 @@ namespace ac {
 
 #define FX_REL_OP_WITH_AC_INT(REL_OP)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
-  inline bool operator REL_OP ( const ac_fixed<W,I,S,Q,O> &op, const ac_int<WI,SI> &op2) {  \
+  __HLS_CONSTEXPR__ inline bool operator REL_OP ( const ac_fixed<W,I,S,Q,O> &op, const ac_int<WI,SI> &op2) {  \
     return op.operator REL_OP (ac_fixed<WI,WI,SI>(op2));  \
   }  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
-  inline bool operator REL_OP ( ac_int<WI,SI> &op2, const ac_fixed<W,I,S,Q,O> &op) {  \
+  __HLS_CONSTEXPR__ inline bool operator REL_OP ( ac_int<WI,SI> &op2, const ac_fixed<W,I,S,Q,O> &op) {  \
     return ac_fixed<WI,WI,SI>(op2).operator REL_OP (op);  \
   }
 
 #define FX_ASSIGN_OP_WITH_AC_INT(ASSIGN_OP)  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
-  inline ac_fixed<W,I,S,Q,O> &operator ASSIGN_OP ( ac_fixed<W,I,S,Q,O> &op, const ac_int<WI,SI> &op2) {  \
+  __HLS_CONSTEXPR__ inline ac_fixed<W,I,S,Q,O> &operator ASSIGN_OP ( ac_fixed<W,I,S,Q,O> &op, const ac_int<WI,SI> &op2) {  \
     return op.operator ASSIGN_OP (ac_fixed<WI,WI,SI>(op2));  \
   }  \
   template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O, int WI, bool SI> \
-  inline ac_int<WI,SI> &operator ASSIGN_OP ( ac_int<WI,SI> &op, const ac_fixed<W,I,S,Q,O> &op2) {  \
+  __HLS_CONSTEXPR__ inline ac_int<WI,SI> &operator ASSIGN_OP ( ac_int<WI,SI> &op, const ac_fixed<W,I,S,Q,O> &op2) {  \
     return op.operator ASSIGN_OP (op2.to_ac_int());  \
   }  
 
@@ -1429,27 +1513,27 @@ namespace ac {
     // Relational Operators with double --------------------------------------
     
     template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
-    inline bool operator == ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
+    __HLS_CONSTEXPR__ inline bool operator == ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
       return op2.operator == (op); 
     }
     template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
-    inline bool operator != ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
+    __HLS_CONSTEXPR__ inline bool operator != ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
       return op2.operator != (op); 
     }
     template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
-    inline bool operator > ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
+    __HLS_CONSTEXPR__ inline bool operator > ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
       return op2.operator < (op); 
     }
     template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
-    inline bool operator < ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
+    __HLS_CONSTEXPR__ inline bool operator < ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
       return op2.operator > (op); 
     }
     template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
-    inline bool operator <= ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
+    __HLS_CONSTEXPR__ inline bool operator <= ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
       return op2.operator >= (op); 
     }
     template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
-    inline bool operator >= ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
+    __HLS_CONSTEXPR__ inline bool operator >= ( double op, const ac_fixed<W,I,S,Q,O> &op2) {
       return op2.operator <= (op); 
     }
     // -------------------------------------- End of Relational Operators with double 
@@ -105,20 +105,96 @@
 #endif // linux
 #endif
 #include <algorithm>
+#include <cstring>
 #include <HLS/math.h>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// ac_private::ap_int is the vendor __ap_int type when compiling with i++. Other compilers, or
+// defining AC_INT_LIMB_BACKEND, use the portable limb_int backend instead (bit-exact, slower
+// for wide types), so emulation can be built with stock GCC or Clang.
+#if !defined(__INTELFPGA_COMPILER__) && !defined(AC_INT_LIMB_BACKEND)
+#define AC_INT_LIMB_BACKEND
+#endif
+
+// Divider that / and % use for operands wider than 64 bits with the vendor backend, see
+// ac_int::divide.
+#ifndef AC_INT_DIV_STAGES
+#define AC_INT_DIV_STAGES 1
+#endif
+#ifndef AC_INT_DIV_ALGORITHM
+#define AC_INT_DIV_ALGORITHM AC_DIV_RESTORING
+#endif
+
+// pipeline register between the stages of an array divider
+#if defined(__INTELFPGA_COMPILER__) && !defined(HLS_X86) && defined(__has_builtin)
+#if __has_builtin(__builtin_fpga_reg)
+#define AC_DIV_REG(x) __builtin_fpga_reg(x)
+#endif
+#endif
+#ifndef AC_DIV_REG
+#define AC_DIV_REG(x) (x)
+#endif
+
+// bit pattern of a float or double, a constant expression where the compiler has
+// __builtin_bit_cast
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define AC_BIT_CAST(T, x) __builtin_bit_cast(T, x)
+#endif
+#endif
+#ifndef AC_BIT_CAST
+#define AC_BIT_CAST(T, x) ac_private::bit_cast<T>(x)
+#endif
+
+// Values of the limb backend wider than this many 64 bit limbs are converted to decimal
+// (to_string, to_chars) by divide and conquer instead of chunk by chunk.
+#ifndef AC_INT_TO_CHARS_DC_LIMBS
+#define AC_INT_TO_CHARS_DC_LIMBS 8
+#endif
+
+// Products of the limb backend with both operands at least this many 64 bit limbs wide
+// use Karatsuba instead of schoolbook multiplication.
+#ifndef AC_INT_KARATSUBA_LIMBS
+#define AC_INT_KARATSUBA_LIMBS 32
+#endif
+
 // __HLS_CONSTEXPR__ is defined as constexpr as long as no DEBUG flag is
 // enabled.
-#if defined(DEBUG_AC_INT_ERROR) || defined(DEBUG_AC_INT_WARNING)
+#if defined(DEBUG_AC_INT_ERROR) || defined(DEBUG_AC_INT_WARNING) || defined(DEBUG_AC_INT_STATS)
 #define __HLS_CONSTEXPR__
-#pragma message ("using ac_int debug macros (DEBUG_AC_INT_WARNING/DEBUG_AC_INT_ERROR) may result in performance degradation when compiling for FPGA.")
+#pragma message ("using ac_int debug macros (DEBUG_AC_INT_WARNING/DEBUG_AC_INT_ERROR/DEBUG_AC_INT_STATS) may result in performance degradation when compiling for FPGA.")
 #else
 #define __HLS_CONSTEXPR__ constexpr
 #define __HLS_USE_CONSTEXPR__
 #endif
 
+// DEBUG_AC_INT_STATS counts overflowing assignments per source location and type
+// instead of printing every one, and prints the counts sorted at exit. Only 1 in
+// AC_INT_STATS_SAMPLE assignments, picked at random, is checked. The table has
+// AC_INT_STATS_SLOTS entries, overflows at further locations are counted as dropped.
+#ifdef DEBUG_AC_INT_STATS
+#ifndef AC_INT_STATS_SAMPLE
+#define AC_INT_STATS_SAMPLE 1
+#endif
+#ifndef AC_INT_STATS_SLOTS
+#define AC_INT_STATS_SLOTS 4096
+#endif
+#include <atomic>
+// source location of the caller, as defaulted arguments of the checked constructors
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+#define AC_INT_SRC_LOC , const char *ac_src_file = __builtin_FILE(), int ac_src_line = __builtin_LINE()
+#else
+#define AC_INT_SRC_LOC , const char *ac_src_file = "unknown", int ac_src_line = 0
+#endif
+#define AC_INT_SRC_LOC_ARGS , ac_src_file, ac_src_line
+#else
+#define AC_INT_SRC_LOC
+#define AC_INT_SRC_LOC_ARGS
+#endif
+
 #ifdef __AC_NAMESPACE
 namespace __AC_NAMESPACE {
 #endif
@@ -142,6 +218,7 @@ typedef signed   long long Slong;
 
 enum ac_base_mode { AC_BIN=2, AC_OCT=8, AC_DEC=10, AC_HEX=16 };
 enum ac_special_val {AC_VAL_DC, AC_VAL_0, AC_VAL_MIN, AC_VAL_MAX, AC_VAL_QUANTUM};
+enum ac_div_algorithm { AC_DIV_RESTORING, AC_DIV_NON_RESTORING };
 
 static bool warned_undef = false;
 
@@ -149,8 +226,946 @@ template <int W, bool S> class ac_int;
 
 namespace ac_private {
 
+#ifdef AC_INT_LIMB_BACKEND
+  //////////////////////////////////////////////////////////////////////////////
+  //  Portable backend: limb_int
+  //
+  //  N bit two's complement integer stored in 64 bit limbs, least significant
+  //  limb first. The bits of the top limb above N always hold the sign (S) or
+  //  zero extension of bit N-1, so limbs can be compared and widened without
+  //  masking. Arithmetic wraps modulo 2^N and mixed operands are converted to
+  //  the wider type (the unsigned one if equally wide), as with the vendor
+  //  __ap_int type. A single limb (N <= 64) uses native 64 bit operations.
+  //////////////////////////////////////////////////////////////////////////////
+  template<int N, bool S> class limb_int;
+
+  template<typename A, typename B> struct limb_common {};
+  template<int N1, bool S1, int N2, bool S2>
+  struct limb_common< limb_int<N1,S1>, limb_int<N2,S2> > {
+    typedef limb_int<AC_MAX(N1, N2), N1 == N2 ? (S1 && S2) : (N1 > N2 ? S1 : S2)> type;
+  };
+
+  // built-in integer type T as a limb_int
+  template<typename T>
+  struct limb_of {
+    typedef limb_int<std::is_same<T, bool>::value ? 1 : (int) sizeof(T) * 8, std::is_signed<T>::value> type;
+  };
+
+  // 64 x 64 -> 128 bit product, returns the low limb
+  constexpr Ulong limb_mul(Ulong a, Ulong b, Ulong &hi) {
+  #ifdef __SIZEOF_INT128__
+    const unsigned __int128 p = (unsigned __int128) a * b;
+    hi = (Ulong) (p >> 64);
+    return (Ulong) p;
+  #else
+    const Ulong a0 = a & 0xffffffffu, a1 = a >> 32, b0 = b & 0xffffffffu, b1 = b >> 32;
+    const Ulong p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0;
+    const Ulong mid = (p00 >> 32) + (p01 & 0xffffffffu) + (p10 & 0xffffffffu);
+    hi = a1 * b1 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (p00 & 0xffffffffu);
+  #endif
+  }
+
+  // Magnitudes as limb arrays, least significant limb first
+
+  // r[0, n + m) = a[0, n) * b[0, m), schoolbook
+  constexpr void limb_mul_school(const Ulong *a, int n, const Ulong *b, int m, Ulong *r) {
+  #ifdef __SIZEOF_INT128__
+    // column by column into a 192 bit accumulator
+    unsigned __int128 acc = 0;
+    for (int k = 0; k < n + m - 1; k++) {
+      Ulong top = 0;
+      for (int i = k < m ? 0 : k - m + 1; i <= k && i < n; i++) {
+        const unsigned __int128 p = (unsigned __int128) a[i] * b[k-i];
+        acc += p;
+        top += acc < p;
+      }
+      r[k] = (Ulong) acc;
+      acc = (acc >> 64) | ((unsigned __int128) top << 64);
+    }
+    r[n+m-1] = (Ulong) acc;
+  #else
+    for (int i = 0; i < n + m; i++)
+      r[i] = 0;
+    for (int i = 0; i < n; i++) {
+      Ulong carry = 0;
+      for (int j = 0; j < m; j++) {
+        Ulong hi = 0;
+        const Ulong lo = limb_mul(a[i], b[j], hi);
+        Ulong acc = r[i+j] + lo;
+        hi += acc < lo;
+        acc += carry;
+        hi += acc < carry;
+        r[i+j] = acc;
+        carry = hi;
+      }
+      r[i+m] = carry;
+    }
+  #endif
+  }
+
+  // r[0, n) += a[0, m) for m <= n, returns the carry out
+  constexpr Ulong limb_add_to(Ulong *r, int n, const Ulong *a, int m) {
+    Ulong c = 0;
+    for (int i = 0; i < n && (i < m || c); i++) {
+      const Ulong s = r[i] + c;
+      c = s < c;
+      r[i] = s + (i < m ? a[i] : 0);
+      c += r[i] < s;
+    }
+    return c;
+  }
+  // r[0, n) -= a[0, m) for m <= n, returns the borrow out
+  constexpr Ulong limb_sub_from(Ulong *r, int n, const Ulong *a, int m) {
+    Ulong c = 0;
+    for (int i = 0; i < n && (i < m || c); i++) {
+      const Ulong t = i < m ? a[i] : 0;
+      const Ulong s = r[i] - c;
+      c = (r[i] < c) | (s < t);
+      r[i] = s - t;
+    }
+    return c;
+  }
+
+  // limbs of scratch space limb_mul_n needs for operands of up to n limbs
+  constexpr int limb_mul_scratch(int n) { return 8 * n + 128; }
+
+  // r[0, n + m) = a[0, n) * b[0, m), Karatsuba from AC_INT_KARATSUBA_LIMBS limbs on, w is
+  // scratch space of limb_mul_scratch(max(n, m)) limbs
+  constexpr void limb_mul_n(const Ulong *a, int n, const Ulong *b, int m, Ulong *r, Ulong *w) {
+    if (n < m) {
+      limb_mul_n(b, m, a, n, r, w);
+      return;
+    }
+    if (m < AC_MAX(AC_INT_KARATSUBA_LIMBS, 4)) {
+      limb_mul_school(a, n, b, m, r);
+      return;
+    }
+    const int h = (n + 1) / 2;
+    if (m <= h) {
+      // unbalanced, multiply b by pieces of m limbs of a
+      for (int i = 0; i < n + m; i++)
+        r[i] = 0;
+      for (int i = 0; i < n; i += m) {
+        const int k = AC_MIN(m, n - i);
+        limb_mul_n(a + i, k, b, m, w, w + k + m);
+        limb_add_to(r + i, n + m - i, w, k + m);
+      }
+      return;
+    }
+    // a = a1 B^h + a0, b = b1 B^h + b0,
+    // a b = a1 b1 B^2h + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) B^h + a0 b0
+    limb_mul_n(a, h, b, h, r, w);
+    limb_mul_n(a + h, n - h, b + h, m - h, r + 2 * h, w);
+    Ulong *sa = w, *sb = w + h + 1, *z1 = w + 2 * h + 2;
+    for (int i = 0; i < h; i++) {
+      sa[i] = a[i];
+      sb[i] = b[i];
+    }
+    sa[h] = limb_add_to(sa, h, a + h, n - h);
+    sb[h] = limb_add_to(sb, h, b + h, m - h);
+    const int ns = h + (sa[h] != 0), ms = h + (sb[h] != 0);
+    limb_mul_n(sa, ns, sb, ms, z1, w + 4 * h + 4);
+    for (int i = ns + ms; i < 2 * h + 2; i++)
+      z1[i] = 0;
+    limb_sub_from(z1, 2 * h + 2, r, 2 * h);
+    limb_sub_from(z1, 2 * h + 2, r + 2 * h, n + m - 2 * h);
+    limb_add_to(r + h, n + m - h, z1, AC_MIN(2 * h + 2, n + m - h));
+  }
+
+  // 32 bit digit i of a limb array
+  constexpr unsigned limb_digit(const Ulong *x, int i) {
+    return (unsigned) (x[i / 2] >> (i % 2 * 32));
+  }
+  constexpr void limb_from_digits(const unsigned *d, int nd, Ulong *x, int n) {
+    for (int i = 0; i < n; i++)
+      x[i] = (2 * i < nd ? (Ulong) d[2*i] : 0) | (2 * i + 1 < nd ? (Ulong) d[2*i+1] << 32 : 0);
+  }
+
+  // q[0, m - n + 1) = u[0, m) / v[0, n) and r[0, n) = u % v, for m >= n and v != 0.
+  // Knuth's algorithm D on 32 bit digits, so 64 bit arithmetic suffices. w is scratch
+  // space of 4 m + 2 digits.
+  constexpr void limb_divmod_n(const Ulong *u, int m, const Ulong *v, int n, Ulong *q, Ulong *r, unsigned *w) {
+    int dm = 2 * m, dn = 2 * n;
+    while (dm > 0 && !limb_digit(u, dm - 1)) dm--;
+    while (dn > 0 && !limb_digit(v, dn - 1)) dn--;
+    if (dm < dn) {
+      for (int i = 0; i < m - n + 1; i++)
+        q[i] = 0;
+      for (int i = 0; i < n; i++)
+        r[i] = i < m ? u[i] : 0;
+      return;
+    }
+    unsigned *qd = w, *un = w + dm - dn + 1, *vn = un + dm + 1;
+    if (dn == 1) {
+      const Ulong d = limb_digit(v, 0);
+      Ulong k = 0;
+      for (int j = dm - 1; j >= 0; j--) {
+        const Ulong x = (k << 32) | limb_digit(u, j);
+        qd[j] = (unsigned) (x / d);
+        k = x - qd[j] * d;
+      }
+      limb_from_digits(qd, dm, q, m - n + 1);
+      limb_from_digits(0, 0, r, n);
+      r[0] = k;
+      return;
+    }
+    // normalize so that the top digit of v has its top bit set
+    int s = 0;
+    for (unsigned t = limb_digit(v, dn - 1); !(t & 0x80000000u); t <<= 1)
+      s++;
+    for (int i = dn - 1; i > 0; i--)
+      vn[i] = (limb_digit(v, i) << s) | (unsigned) ((Ulong) limb_digit(v, i - 1) >> (32 - s));
+    vn[0] = limb_digit(v, 0) << s;
+    un[dm] = (unsigned) ((Ulong) limb_digit(u, dm - 1) >> (32 - s));
+    for (int i = dm - 1; i > 0; i--)
+      un[i] = (limb_digit(u, i) << s) | (unsigned) ((Ulong) limb_digit(u, i - 1) >> (32 - s));
+    un[0] = limb_digit(u, 0) << s;
+
+    const Ulong b = (Ulong) 1 << 32;
+    for (int j = dm - dn; j >= 0; j--) {
+      // estimate the quotient digit from the top two digits, it is at most 2 too large
+      const Ulong num = ((Ulong) un[j+dn] << 32) | un[j+dn-1];
+      Ulong qhat = num / vn[dn-1];
+      Ulong rhat = num - qhat * vn[dn-1];
+      while (qhat >= b || qhat * vn[dn-2] > ((rhat << 32) | un[j+dn-2])) {
+        qhat--;
+        rhat += vn[dn-1];
+        if (rhat >= b) break;
+      }
+      // multiply and subtract
+      Slong k = 0, t = 0;
+      for (int i = 0; i < dn; i++) {
+        const Ulong p = qhat * vn[i];
+        t = (Slong) un[i+j] - k - (Slong) (p & 0xffffffffu);
+        un[i+j] = (unsigned) t;
+        k = (Slong) (p >> 32) - (t >> 32);
+      }
+      t = (Slong) un[j+dn] - k;
+      un[j+dn] = (unsigned) t;
+      qd[j] = (unsigned) qhat;
+      // add back if qhat was one too large
+      if (t < 0) {
+        qd[j]--;
+        Ulong c = 0;
+        for (int i = 0; i < dn; i++) {
+          const Ulong a = (Ulong) un[i+j] + vn[i] + c;
+          un[i+j] = (unsigned) a;
+          c = a >> 32;
+        }
+        un[j+dn] += (unsigned) c;
+      }
+    }
+    limb_from_digits(qd, dm - dn + 1, q, m - n + 1);
+    for (int i = 0; i < dn - 1; i++)
+      un[i] = (un[i] >> s) | (unsigned) ((Ulong) un[i+1] << (32 - s));
+    un[dn-1] >>= s;
+    limb_from_digits(un, dn, r, n);
+  }
+
+  template<int N, bool S>
+  class limb_int {
+  public:
+    enum { L = N > 0 ? (N + 63) / 64 : 1, TOP = N > 0 ? N - 64 * (L - 1) : 64 };
+    Ulong v[L];
+
+    limb_int() = default;
+    template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+    constexpr limb_int(T t) : v() {
+      const bool neg = std::is_signed<T>::value ? (Slong) t < 0 : false;
+      v[0] = (Ulong) t;
+      for (int i = 1; i < L; i++)
+        v[i] = neg ? ~(Ulong) 0 : 0;
+      normalize();
+    }
+    template<int N2, bool S2>
+    constexpr limb_int(const limb_int<N2, S2> &op) : v() {
+      const Ulong ext = op.is_neg() ? ~(Ulong) 0 : 0;
+      for (int i = 0; i < L; i++)
+        v[i] = i < limb_int<N2, S2>::L ? op.v[i] : ext;
+      normalize();
+    }
+
+    constexpr void normalize() {
+      if (TOP < 64) {
+        const int sh = 64 - TOP;
+        v[L-1] = S ? (Ulong) ((Slong) (v[L-1] << sh) >> sh) : v[L-1] & (~(Ulong) 0 >> sh);
+      }
+    }
+    constexpr bool is_neg() const { return S && (Slong) v[L-1] < 0; }
+
+    // conversion to built-in types keeps the low 64 bits
+    constexpr operator Slong() const { return (Slong) v[0]; }
+    constexpr explicit operator bool() const {
+      for (int i = 0; i < L; i++)
+        if (v[i]) return true;
+      return false;
+    }
+    constexpr bool operator !() const { return !(bool) *this; }
+
+    static constexpr limb_int add(const limb_int &a, const limb_int &b) {
+      limb_int r = 0;
+      if (L == 1) {
+        r.v[0] = a.v[0] + b.v[0];
+      } else {
+        Ulong c = 0;
+        for (int i = 0; i < L; i++) {
+          const Ulong s = a.v[i] + c;
+          const Ulong t = s + b.v[i];
+          c = (s < c) | (t < s);
+          r.v[i] = t;
+        }
+      }
+      r.normalize();
+      return r;
+    }
+    static constexpr limb_int sub(const limb_int &a, const limb_int &b) {
+      limb_int r = 0;
+      if (L == 1) {
+        r.v[0] = a.v[0] - b.v[0];
+      } else {
+        Ulong c = 0;
+        for (int i = 0; i < L; i++) {
+          const Ulong s = a.v[i] - c;
+          c = (a.v[i] < c) | (s < b.v[i]);
+          r.v[i] = s - b.v[i];
+        }
+      }
+      r.normalize();
+      return r;
+    }
+    // product modulo 2^(64 L) of the magnitudes, negated if the signs differ. Only the
+    // nonzero limbs of the magnitudes are multiplied, so the product of a narrow type
+    // widened to its full width costs as much as the narrow operands.
+    static constexpr limb_int mul(const limb_int &a, const limb_int &b) {
+      limb_int r = 0;
+      if (L == 1) {
+        r.v[0] = a.v[0] * b.v[0];
+        r.normalize();
+        return r;
+      }
+      const bool na = a.is_neg(), nb = b.is_neg();
+      Ulong x[L] = {}, y[L] = {};
+      limb_abs(a, na, x);
+      limb_abs(b, nb, y);
+      int nx = L, ny = L;
+      while (nx > 0 && !x[nx-1])
+        nx--;
+      while (ny > 0 && !y[ny-1])
+        ny--;
+      if (nx + ny <= L) {
+        // Karatsuba needs both operands, so one at most L / 2 limbs, of AC_INT_KARATSUBA_LIMBS
+        Ulong w[L >= 2 * AC_INT_KARATSUBA_LIMBS ? limb_mul_scratch(L) : 1] = {};
+        if (nx && ny)
+          limb_mul_n(x, nx, y, ny, r.v, w);
+      } else {
+        // truncated schoolbook, limbs at and above L are dropped
+        for (int i = 0; i < nx; i++) {
+          Ulong carry = 0;
+          for (int j = 0; j < ny && i + j < L; j++) {
+            Ulong hi = 0;
+            const Ulong lo = limb_mul(x[i], y[j], hi);
+            Ulong acc = r.v[i+j] + lo;
+            hi += acc < lo;
+            acc += carry;
+            hi += acc < carry;
+            r.v[i+j] = acc;
+            carry = hi;
+          }
+          if (i + ny < L)
+            r.v[i+ny] = carry;
+        }
+      }
+      if (na != nb) r = sub(0, r);
+      r.normalize();
+      return r;
+    }
+    // quotient truncated towards zero, remainder with the sign of the dividend
+    static constexpr limb_int divmod(const limb_int &a, const limb_int &b, limb_int &rem) {
+      limb_int q = 0;
+      rem = 0;
+      if (L == 1) {
+        if (S) {
+          const Slong x = (Slong) a.v[0], y = (Slong) b.v[0];
+          q.v[0] = y == -1 ? (Ulong) 0 - (Ulong) x : (Ulong) (x / y);
+          rem.v[0] = y == -1 ? 0 : (Ulong) (x % y);
+        } else {
+          q.v[0] = a.v[0] / b.v[0];
+          rem.v[0] = a.v[0] % b.v[0];
+        }
+        q.normalize();
+        rem.normalize();
+        return q;
+      }
+      const bool na = a.is_neg(), nb = b.is_neg();
+      Ulong x[L] = {}, y[L] = {}, qu[L] = {}, ru[L] = {};
+      unsigned w[4 * L + 2] = {};
+      limb_abs(a, na, x);
+      limb_abs(b, nb, y);
+      int ny = L;
+      while (ny > 0 && !y[ny-1])
+        ny--;
+      if (ny) {
+        limb_divmod_n(x, L, y, ny, qu, ru, w);
+      } else {
+        // as a restoring divider: all ones and the dividend
+        for (int i = 0; i < L; i++) {
+          qu[i] = ~(Ulong) 0;
+          ru[i] = x[i];
+        }
+      }
+      for (int i = 0; i < L; i++) {
+        q.v[i] = qu[i];
+        rem.v[i] = ru[i];
+      }
+      if (na != nb) q = sub(0, q);
+      if (na) rem = sub(0, rem);
+      q.normalize();
+      rem.normalize();
+      return q;
+    }
+    static constexpr void limb_abs(const limb_int &a, bool neg, Ulong *m) {
+      Ulong c = neg;
+      for (int i = 0; i < L; i++) {
+        const Ulong t = neg ? ~a.v[i] : a.v[i];
+        m[i] = t + c;
+        c = c && m[i] == 0;
+      }
+    }
+    static constexpr bool equal(const limb_int &a, const limb_int &b) {
+      for (int i = 0; i < L; i++)
+        if (a.v[i] != b.v[i]) return false;
+      return true;
+    }
+    static constexpr bool less(const limb_int &a, const limb_int &b) {
+      if (S && (Slong) a.v[L-1] != (Slong) b.v[L-1])
+        return (Slong) a.v[L-1] < (Slong) b.v[L-1];
+      for (int i = L - 1; i >= 0; i--)
+        if (a.v[i] != b.v[i]) return a.v[i] < b.v[i];
+      return false;
+    }
+
+    constexpr limb_int shl(Slong k) const {
+      limb_int r = 0;
+      if (k < 0 || k >= N) return r;
+      if (L == 1) {
+        r.v[0] = v[0] << k;
+      } else {
+        const int w = (int) (k / 64), b = (int) (k % 64);
+        for (int i = L - 1; i >= w; i--)
+          r.v[i] = (v[i-w] << b) | (b && i - w > 0 ? v[i-w-1] >> (64 - b) : 0);
+      }
+      r.normalize();
+      return r;
+    }
+    constexpr limb_int shr(Slong k) const {
+      const Ulong ext = is_neg() ? ~(Ulong) 0 : 0;
+      limb_int r = 0;
+      if (k < 0) return r;
+      if (k >= N) {
+        for (int i = 0; i < L; i++)
+          r.v[i] = ext;
+        return r;
+      }
+      if (L == 1) {
+        r.v[0] = S ? (Ulong) ((Slong) v[0] >> k) : v[0] >> k;
+      } else {
+        const int w = (int) (k / 64), b = (int) (k % 64);
+        for (int i = 0; i < L; i++) {
+          const Ulong lo = i + w < L ? v[i+w] : ext;
+          const Ulong hi = i + w + 1 < L ? v[i+w+1] : ext;
+          r.v[i] = b ? (lo >> b) | (hi << (64 - b)) : lo;
+        }
+      }
+      return r;
+    }
+
+    constexpr limb_int operator +() const { return *this; }
+    constexpr limb_int operator -() const { return sub(0, *this); }
+    constexpr limb_int operator ~() const {
+      limb_int r = 0;
+      for (int i = 0; i < L; i++)
+        r.v[i] = ~v[i];
+      r.normalize();
+      return r;
+    }
+
+    template<typename T> constexpr limb_int &operator +=(const T &op) { return *this = limb_int(*this + op); }
+    template<typename T> constexpr limb_int &operator -=(const T &op) { return *this = limb_int(*this - op); }
+    template<typename T> constexpr limb_int &operator *=(const T &op) { return *this = limb_int(*this * op); }
+    template<typename T> constexpr limb_int &operator /=(const T &op) { return *this = limb_int(*this / op); }
+    template<typename T> constexpr limb_int &operator %=(const T &op) { return *this = limb_int(*this % op); }
+    template<typename T> constexpr limb_int &operator &=(const T &op) { return *this = limb_int(*this & op); }
+    template<typename T> constexpr limb_int &operator |=(const T &op) { return *this = limb_int(*this | op); }
+    template<typename T> constexpr limb_int &operator ^=(const T &op) { return *this = limb_int(*this ^ op); }
+    template<typename T> constexpr limb_int &operator <<=(const T &op) { return *this = shl((Slong) op); }
+    template<typename T> constexpr limb_int &operator >>=(const T &op) { return *this = shr((Slong) op); }
+    constexpr limb_int &operator ++() { return *this += 1; }
+    constexpr limb_int &operator --() { return *this -= 1; }
+    constexpr limb_int operator ++(int) { limb_int t = *this; *this += 1; return t; }
+    constexpr limb_int operator --(int) { limb_int t = *this; *this -= 1; return t; }
+  };
+
+  template<int N, bool S>
+  constexpr limb_int<N,S> limb_div(const limb_int<N,S> &a, const limb_int<N,S> &b, bool remainder) {
+    limb_int<N,S> r = 0;
+    const limb_int<N,S> q = limb_int<N,S>::divmod(a, b, r);
+    return remainder ? r : q;
+  }
+
+  template<int N, bool S>
+  constexpr limb_int<N,S> limb_and(const limb_int<N,S> &a, const limb_int<N,S> &b) {
+    limb_int<N,S> r = 0;
+    for (int i = 0; i < limb_int<N,S>::L; i++)
+      r.v[i] = a.v[i] & b.v[i];
+    return r;
+  }
+  template<int N, bool S>
+  constexpr limb_int<N,S> limb_or(const limb_int<N,S> &a, const limb_int<N,S> &b) {
+    limb_int<N,S> r = 0;
+    for (int i = 0; i < limb_int<N,S>::L; i++)
+      r.v[i] = a.v[i] | b.v[i];
+    return r;
+  }
+  template<int N, bool S>
+  constexpr limb_int<N,S> limb_xor(const limb_int<N,S> &a, const limb_int<N,S> &b) {
+    limb_int<N,S> r = 0;
+    for (int i = 0; i < limb_int<N,S>::L; i++)
+      r.v[i] = a.v[i] ^ b.v[i];
+    return r;
+  }
+
+  // shifts keep the type of the left operand
+  template<int N, bool S, typename T>
+  constexpr typename std::enable_if<std::is_integral<T>::value, limb_int<N,S> >::type
+  operator <<(const limb_int<N,S> &a, T k) { return a.shl((Slong) k); }
+  template<int N, bool S, typename T>
+  constexpr typename std::enable_if<std::is_integral<T>::value, limb_int<N,S> >::type
+  operator >>(const limb_int<N,S> &a, T k) { return a.shr((Slong) k); }
+  template<int N, bool S, int N2, bool S2>
+  constexpr limb_int<N,S> operator <<(const limb_int<N,S> &a, const limb_int<N2,S2> &k) { return a.shl((Slong) k); }
+  template<int N, bool S, int N2, bool S2>
+  constexpr limb_int<N,S> operator >>(const limb_int<N,S> &a, const limb_int<N2,S2> &k) { return a.shr((Slong) k); }
+
+  #define LIMB_INT_BIN_OP(BIN_OP, RTYPE, EXPR) \
+  template<int N1, bool S1, int N2, bool S2> \
+  constexpr RTYPE operator BIN_OP (const limb_int<N1,S1> &a, const limb_int<N2,S2> &b) { \
+    typedef typename limb_common< limb_int<N1,S1>, limb_int<N2,S2> >::type C; \
+    return EXPR; \
+  } \
+  template<int N, bool S, typename T> \
+  constexpr typename std::enable_if<std::is_integral<T>::value, \
+    typename limb_common< limb_int<N,S>, typename limb_of<T>::type >::type>::type \
+  operator BIN_OP (const limb_int<N,S> &a, T b) { \
+    return a BIN_OP typename limb_of<T>::type(b); \
+  } \
+  template<int N, bool S, typename T> \
+  constexpr typename std::enable_if<std::is_integral<T>::value, \
+    typename limb_common< typename limb_of<T>::type, limb_int<N,S> >::type>::type \
+  operator BIN_OP (T a, const limb_int<N,S> &b) { \
+    return typename limb_of<T>::type(a) BIN_OP b; \
+  }
+
+  #define LIMB_INT_REL_OP(REL_OP, EXPR) \
+  template<int N1, bool S1, int N2, bool S2> \
+  constexpr bool operator REL_OP (const limb_int<N1,S1> &a, const limb_int<N2,S2> &b) { \
+    typedef typename limb_common< limb_int<N1,S1>, limb_int<N2,S2> >::type C; \
+    return EXPR; \
+  } \
+  template<int N, bool S, typename T> \
+  constexpr typename std::enable_if<std::is_integral<T>::value, bool>::type \
+  operator REL_OP (const limb_int<N,S> &a, T b) { \
+    return a REL_OP typename limb_of<T>::type(b); \
+  } \
+  template<int N, bool S, typename T> \
+  constexpr typename std::enable_if<std::is_integral<T>::value, bool>::type \
+  operator REL_OP (T a, const limb_int<N,S> &b) { \
+    return typename limb_of<T>::type(a) REL_OP b; \
+  }
+
+  #define LIMB_INT_COMMON typename limb_common< limb_int<N1,S1>, limb_int<N2,S2> >::type
+  LIMB_INT_BIN_OP(+, LIMB_INT_COMMON, C::add(C(a), C(b)))
+  LIMB_INT_BIN_OP(-, LIMB_INT_COMMON, C::sub(C(a), C(b)))
+  LIMB_INT_BIN_OP(*, LIMB_INT_COMMON, C::mul(C(a), C(b)))
+  LIMB_INT_BIN_OP(/, LIMB_INT_COMMON, limb_div(C(a), C(b), false))
+  LIMB_INT_BIN_OP(%, LIMB_INT_COMMON, limb_div(C(a), C(b), true))
+  LIMB_INT_BIN_OP(&, LIMB_INT_COMMON, limb_and(C(a), C(b)))
+  LIMB_INT_BIN_OP(|, LIMB_INT_COMMON, limb_or(C(a), C(b)))
+  LIMB_INT_BIN_OP(^, LIMB_INT_COMMON, limb_xor(C(a), C(b)))
+  LIMB_INT_REL_OP(==, C::equal(C(a), C(b)))
+  LIMB_INT_REL_OP(!=, !C::equal(C(a), C(b)))
+  LIMB_INT_REL_OP(<, C::less(C(a), C(b)))
+  LIMB_INT_REL_OP(>, C::less(C(b), C(a)))
+  LIMB_INT_REL_OP(<=, !C::less(C(b), C(a)))
+  LIMB_INT_REL_OP(>=, !C::less(C(a), C(b)))
+  #undef LIMB_INT_COMMON
+  #undef LIMB_INT_REL_OP
+  #undef LIMB_INT_BIN_OP
+
+  // largest power of base below 2^32, k is set to its exponent
+  constexpr Ulong limb_radix_chunk(unsigned base, int &k) {
+    Ulong p = base;
+    k = 1;
+    while (p * base <= 0xffffffffu) {
+      p *= base;
+      k++;
+    }
+    return p;
+  }
+
+  // Divides m[0, n) in place by D (d if D is 0), D < 2^32, and returns the remainder.
+  // n drops the zero top limbs of the quotient. With a constant D the divisions become
+  // multiplications.
+  template<Ulong D>
+  inline Ulong limb_short_div(Ulong *m, int &n, Ulong d) {
+    const Ulong dd = D ? D : d;
+    Ulong r = 0;
+    for (int i = n - 1; i >= 0; i--) {
+      const Ulong hi = (r << 32) | (m[i] >> 32);
+      const Ulong qh = hi / dd;
+      const Ulong lo = ((hi - qh * dd) << 32) | (m[i] & 0xffffffffu);
+      const Ulong ql = lo / dd;
+      r = lo - ql * dd;
+      m[i] = (qh << 32) | ql;
+    }
+    while (n > 0 && m[n-1] == 0)
+      n--;
+    return r;
+  }
+
+  // The digit writers below write the digits of m[0, n) backwards ending at end, left
+  // padded with zeros to width digits, and return the position of the first digit.
+
+  // base 2^LOG2B, by slicing the bits
+  template<int LOG2B>
+  inline char *limb_digits_pow2(const Ulong *m, int n, char *end, int width) {
+    char *p = end;
+    int top = 0;
+    for (Ulong t = n ? m[n-1] : 0; t; t >>= 1)
+      top++;
+    const Slong bits = n ? 64 * (Slong) (n - 1) + top : 0;
+    for (Slong pos = 0; pos < bits; pos += LOG2B) {
+      const int i = (int) (pos / 64), s = (int) (pos % 64);
+      Ulong d = m[i] >> s;
+      if (s + LOG2B > 64 && i + 1 < n)
+        d |= m[i+1] << (64 - s);
+      *--p = "0123456789abcdef"[d & ((1u << LOG2B) - 1)];
+    }
+    while (end - p < width)
+      *--p = '0';
+    return p;
+  }
+
+  // base B (base if B is 0), one short division per chunk of digits that fits into 32
+  // bits. m is destroyed.
+  template<unsigned B>
+  inline char *limb_digits_chunked(Ulong *m, int n, unsigned base, char *end, int width) {
+    const unsigned b = B ? B : base;
+    int k = 0;
+    const Ulong chunk = limb_radix_chunk(b, k);
+    char *p = end;
+    while (n > 0) {
+      unsigned r = (unsigned) limb_short_div<B == 10 ? 1000000000 : 0>(m, n, chunk);
+      // all but the most significant chunk have k digits
+      for (int j = 0; j < k && (n > 0 || r); j++) {
+        *--p = "0123456789abcdef"[r % b];
+        r /= b;
+      }
+    }
+    while (end - p < width)
+      *--p = '0';
+    return p;
+  }
+
+  // a[0, n) >= b[0, m) for m <= n
+  inline bool limb_geq(const Ulong *a, int n, const Ulong *b, int m) {
+    for (int i = n - 1; i >= m; i--)
+      if (a[i])
+        return true;
+    for (int i = m - 1; i >= 0; i--)
+      if (a[i] != b[i])
+        return a[i] > b[i];
+    return true;
+  }
+
+  // mu[0, k + 1) = floor(B^2k / d) for d[0, k) with the top bit set and B = 2^64. Newton's
+  // iteration from the reciprocal of the top half of d, so with Karatsuba multiplication
+  // it costs a few multiplications of k limbs. The estimate is within a few units and is
+  // corrected against B^2k - d mu.
+  inline void limb_reciprocal(const Ulong *d, int k, Ulong *mu) {
+    if (k < AC_MAX(AC_INT_KARATSUBA_LIMBS, 4)) {
+      std::vector<Ulong> u(2 * k + 1), q(k + 2), r(k);
+      std::vector<unsigned> w(8 * k + 6);
+      u[2 * k] = 1;
+      limb_divmod_n(u.data(), 2 * k + 1, d, k, q.data(), r.data(), w.data());
+      for (int i = 0; i <= k; i++)
+        mu[i] = q[i];
+      return;
+    }
+    const int l = k / 2, h = k - l;
+    std::vector<Ulong> muh(h + 1), p(k + h + 2), x(k + 2), t(h + k + 3), w(limb_mul_scratch(k + 2));
+    limb_reciprocal(d + l, h, muh.data());
+    // e = B^(k+h) - d muh, |e| < 4 B^k, and mu ~ muh B^l + muh e / B^2h
+    limb_mul_n(d, k, muh.data(), h + 1, p.data(), w.data());
+    const bool neg = p[k + h] != 0;
+    if (neg) {
+      p[k + h] -= 1;
+    } else {
+      for (int i = 0; i < k + h; i++)
+        p[i] = ~p[i];
+      const Ulong one = 1;
+      limb_add_to(p.data(), k + h, &one, 1);
+    }
+    limb_mul_n(muh.data(), h + 1, p.data(), k + 1, t.data(), w.data());
+    for (int i = 0; i <= h; i++)
+      x[l + i] = muh[i];
+    if (neg)
+      limb_sub_from(x.data(), k + 2, t.data() + 2 * h, l + 2);
+    else
+      limb_add_to(x.data(), k + 2, t.data() + 2 * h, l + 2);
+    // r = B^2k - d x, then 0 <= r < d
+    std::vector<Ulong> r(2 * k + 3), dx(2 * k + 2);
+    limb_mul_n(d, k, x.data(), k + 2, dx.data(), w.data());
+    r[2 * k] = 1;
+    limb_sub_from(r.data(), 2 * k + 3, dx.data(), 2 * k + 2);
+    const Ulong one = 1;
+    while (r[2 * k + 2] >> 63) {
+      limb_sub_from(x.data(), k + 2, &one, 1);
+      limb_add_to(r.data(), 2 * k + 3, d, k);
+    }
+    while (limb_geq(r.data(), 2 * k + 3, d, k)) {
+      limb_add_to(x.data(), k + 2, &one, 1);
+      limb_sub_from(r.data(), 2 * k + 3, d, k);
+    }
+    for (int i = 0; i <= k; i++)
+      mu[i] = x[i];
+  }
+
+  // chunk^(2^level) for limb_digits_dc, p of k limbs, and d = p shifted left by s bits so
+  // that its top bit is set, with its reciprocal inv = floor(B^2k / d)
+  struct limb_radix_power {
+    std::vector<Ulong> p, d, inv;
+    int s;
+    explicit limb_radix_power(const std::vector<Ulong> &pw) : p(pw), d(pw.size()), inv(pw.size() + 1), s(0) {
+      const int k = (int) p.size();
+      for (Ulong t = p[k-1]; !(t >> 63); t <<= 1)
+        s++;
+      for (int i = k - 1; i >= 0; i--)
+        d[i] = (p[i] << s) | (s && i ? p[i-1] >> (64 - s) : 0);
+      limb_reciprocal(d.data(), k, inv.data());
+    }
+  };
+
+  // q[0, k + 1) = u[0, n) / p and r[0, k) = u % p for u < B^(2k-1) or u < p^2, so that
+  // u shifted by s is below B^2k, by Barrett reduction with the reciprocal of the
+  // normalized power. w is scratch space of 14 k + 144 limbs.
+  inline void limb_divmod_power(const Ulong *u, int n, const limb_radix_power &pw, Ulong *q, Ulong *r, Ulong *w) {
+    const int k = (int) pw.p.size(), s = pw.s;
+    Ulong *us = w, *t = us + 2 * k + 1, *qd = t + 2 * k + 2, *ws = qd + 2 * k + 1;
+    for (int i = 0; i <= 2 * k; i++)
+      us[i] = 0;
+    for (int i = 0; i < n; i++) {
+      us[i] |= u[i] << s;
+      if (s)
+        us[i+1] = u[i] >> (64 - s);
+    }
+    // the estimate floor(floor(us / B^(k-1)) inv / B^(k+1)) is at most 2 too small
+    limb_mul_n(us + k - 1, k + 1, pw.inv.data(), k + 1, t, ws);
+    for (int i = 0; i <= k; i++)
+      q[i] = t[k + 1 + i];
+    limb_mul_n(q, k + 1, pw.d.data(), k, qd, ws);
+    limb_sub_from(us, k + 1, qd, k + 1);
+    const Ulong one = 1;
+    while (limb_geq(us, k + 1, pw.d.data(), k)) {
+      limb_sub_from(us, k + 1, pw.d.data(), k);
+      limb_add_to(q, k + 1, &one, 1);
+    }
+    for (int i = 0; i < k; i++)
+      r[i] = (us[i] >> s) | (s ? us[i+1] << (64 - s) : 0);
+  }
+
+  // base B (base if B is 0) by divide and conquer: the magnitude is split into quotient
+  // and remainder by the power pw[level] of about half its length and both halves are
+  // converted recursively. The divisions by the powers take a few Karatsuba
+  // multiplications each, so a conversion costs O(M(n) log n) for multiplications M(n).
+  // m is below B^(2k-1) for the k limbs of pw[level], or below pw[level]^2 as the halves
+  // are. w is scratch space of limb_digits_dc_scratch(n) limbs.
+  constexpr int limb_digits_dc_scratch(int n) { return 32 * n + 4096; }
+
+  template<unsigned B>
+  inline char *limb_digits_dc(const Ulong *m, int n, unsigned base, char *end, int width,
+                              const std::vector<limb_radix_power> &pw, int level, Ulong *w) {
+    while (level > 0 && 2 * (int) pw[level-1].p.size() - 1 >= n)
+      level--;
+    if (n <= AC_INT_TO_CHARS_DC_LIMBS || level < 0) {
+      for (int i = 0; i < n; i++)
+        w[i] = m[i];
+      return limb_digits_chunked<B>(w, n, base, end, width);
+    }
+    const int dn = (int) pw[level].p.size();
+    Ulong *q = w, *r = w + dn + 1;
+    limb_divmod_power(m, n, pw[level], q, r, r + dn);
+    int qn = dn + 1, rn = dn;
+    while (qn > 0 && q[qn-1] == 0)
+      qn--;
+    while (rn > 0 && r[rn-1] == 0)
+      rn--;
+    if (!qn)
+      return limb_digits_dc<B>(r, rn, base, end, width, pw, level - 1, r + dn);
+    int k = 0;
+    limb_radix_chunk(B ? B : base, k);
+    const int digits = k << level;
+    char *p = limb_digits_dc<B>(r, rn, base, end, digits, pw, level - 1, r + dn);
+    // the quotient is below pw[level] unless m was not below its square
+    const bool big = qn > dn || (qn == dn && limb_geq(q, qn, pw[level].p.data(), dn));
+    return limb_digits_dc<B>(q, qn, base, p, width > digits ? width - digits : 0, pw, big ? level : level - 1, r + dn);
+  }
+
+  template<unsigned B>
+  inline char *limb_digits_radix(Ulong *m, int n, unsigned base, char *end) {
+    if (n <= AC_INT_TO_CHARS_DC_LIMBS)
+      return limb_digits_chunked<B>(m, n, base, end, 1);
+    // powers of the chunk with their reciprocals and the scratch space, kept per thread
+    // and base
+    static thread_local std::vector<limb_radix_power> pw[17];
+    static thread_local std::vector<Ulong> scratch;
+    std::vector<limb_radix_power> &p = pw[base];
+    if (p.empty()) {
+      int k = 0;
+      p.push_back(limb_radix_power(std::vector<Ulong>(1, limb_radix_chunk(base, k))));
+    }
+    while (2 * (int) p.back().p.size() - 1 < n) {
+      const std::vector<Ulong> &a = p.back().p;
+      std::vector<Ulong> s(2 * a.size()), w(limb_mul_scratch((int) a.size()));
+      limb_mul_n(a.data(), (int) a.size(), a.data(), (int) a.size(), s.data(), w.data());
+      while (s.back() == 0)
+        s.pop_back();
+      p.push_back(limb_radix_power(s));
+    }
+    if ((int) scratch.size() < limb_digits_dc_scratch(n))
+      scratch.resize(limb_digits_dc_scratch(n));
+    return limb_digits_dc<B>(m, n, base, end, 1, p, (int) p.size() - 1, scratch.data());
+  }
+
+  // digits of m[0, n) in base 2 to 16, at least one. m is destroyed.
+  inline char *limb_digits(Ulong *m, int n, unsigned base, char *end) {
+    while (n > 0 && m[n-1] == 0)
+      n--;
+    switch (base) {
+      case 2: return limb_digits_pow2<1>(m, n, end, 1);
+      case 4: return limb_digits_pow2<2>(m, n, end, 1);
+      case 8: return limb_digits_pow2<3>(m, n, end, 1);
+      case 16: return limb_digits_pow2<4>(m, n, end, 1);
+      case 10: return limb_digits_radix<10>(m, n, base, end);
+      default: return limb_digits_radix<0>(m, n, base, end);
+    }
+  }
+
+  // Parses the digits in base 2 to 16 at the start of [first, last) into m[0, n), TOP bits
+  // in the top limb, and returns the end of the digits. Chunks of digits that fit into 64
+  // bits are gathered in a register and then multiplied in. overflow is set if the number
+  // does not fit, m is then the number modulo 2^(64 (n - 1) + TOP).
+  inline const char *limb_from_chars(const char *first, const char *last, unsigned base, Ulong *m, int n, int top, bool &overflow) {
+    for (int i = 0; i < n; i++)
+      m[i] = 0;
+    overflow = false;
+    const char *p = first;
+    while (p != last) {
+      Ulong c = 0, pw = 1;
+      const char *q = p;
+      for (; q != last && pw <= ~(Ulong) 0 / base; q++) {
+        const unsigned ch = (unsigned char) *q;
+        const unsigned d = ch - '0' < 10 ? ch - '0' : (ch | 0x20) - 'a' < 6 ? (ch | 0x20) - 'a' + 10 : 16;
+        if (d >= base)
+          break;
+        c = c * base + d;
+        pw *= base;
+      }
+      if (q == p)
+        break;
+      for (int i = 0; i < n; i++) {
+        Ulong hi = 0;
+        const Ulong lo = limb_mul(m[i], pw, hi);
+        m[i] = lo + c;
+        c = hi + (m[i] < lo);
+      }
+      overflow = overflow || c;
+      p = q;
+    }
+    if (top < 64) {
+      overflow = overflow || (m[n-1] >> top);
+      m[n-1] &= ~(Ulong) 0 >> (64 - top);
+    }
+    return p;
+  }
+
+  // n bytes of p, little or big endian, to the limbs m[0, (n + 7) / 8)
+  inline void limb_from_bytes(const unsigned char *p, int n, bool bigendian, Ulong *m) {
+    for (int i = 0; i < (n + 7) / 8; i++)
+      m[i] = 0;
+  #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (!bigendian) {
+      std::memcpy(m, p, n);
+      return;
+    }
+  #endif
+    for (int i = 0; i < n; i++)
+      m[i / 8] |= (Ulong) p[bigendian ? n - 1 - i : i] << (8 * (i % 8));
+  }
+
+  inline void limb_to_bytes(const Ulong *m, int n, bool bigendian, unsigned char *p) {
+  #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (!bigendian) {
+      std::memcpy(p, m, n);
+      return;
+    }
+  #endif
+    for (int i = 0; i < n; i++)
+      p[bigendian ? n - 1 - i : i] = (unsigned char) (m[i / 8] >> (8 * (i % 8)));
+  }
+
+  // the L limbs of v, as a signed (neg) magnitude, rounded to nearest double: the top 64
+  // significant bits with the rest as a sticky bit are converted, then scaled
+  template<int L>
+  constexpr double limb_to_double(const Ulong *v, bool neg) {
+    Ulong m[L] = {};
+    Ulong c = neg;
+    for (int i = 0; i < L; i++) {
+      m[i] = (neg ? ~v[i] : v[i]) + c;
+      c = c && !m[i];
+    }
+    int t = L - 1;
+    while (t > 0 && !m[t])
+      t--;
+    if (!m[t])
+      return 0;
+    int lz = 0;
+    while (!(m[t] >> (63 - lz)))
+      lz++;
+    Ulong hi = m[t] << lz;
+    bool sticky = false;
+    if (t > 0) {
+      hi |= lz ? m[t-1] >> (64 - lz) : 0;
+      sticky = lz ? (m[t-1] << lz) != 0 : m[t-1] != 0;
+      for (int i = 0; i < t - 1; i++)
+        sticky = sticky || m[i];
+    }
+    double d = (double) (hi | sticky);
+    int e = 64 * t - lz;
+    for (; e >= 32; e -= 32)
+      d *= (Ulong) 1 << 32;
+    for (; e <= -32; e += 32)
+      d /= (Ulong) 1 << 32;
+    d = e < 0 ? d / ((Ulong) 1 << -e) : d * ((Ulong) 1 << e);
+    return neg ? -d : d;
+  }
+
+  template<int Bits> using ap_int = limb_int<Bits, true>;
+  template<int Bits> using ap_uint = limb_int<Bits, false>;
+#else
   template<int Bits> using ap_int = int __attribute__((__ap_int(Bits)));
   template<unsigned int Bits> using ap_uint = unsigned int __attribute__((__ap_int(Bits)));
+#endif
 
   enum {long_w = std::numeric_limits<unsigned long>::digits};
 
@@ -159,32 +1174,129 @@ namespace ac_private {
   inline double mgc_floor(double d) { return floor(d); }
 
   #define AC_ASSERT(cond, msg) ac_private::ac_assert(cond, __FILE__, __LINE__, msg)
-  inline void ac_assert(bool condition, const char *file=0, int line=0, const char *msg=0) {
+  // only reached when the condition failed
+  inline void ac_assert_failed(const char *file, int line, const char *msg) {
+    (void)file; (void)line; (void)msg;
   #ifdef HLS_X86
     #ifndef AC_USER_DEFINED_ASSERT
-    if(!condition) {
 #if defined (__linux__)
-      std::cerr << "Assert";
-      if(file)
-        std::cerr << " in file " << file << ":" << line;
-      if(msg)
-        std::cerr << " " << msg;
-      std::cerr << std::endl;
+    std::cerr << "Assert";
+    if(file)
+      std::cerr << " in file " << file << ":" << line;
+    if(msg)
+      std::cerr << " " << msg;
+    std::cerr << std::endl;
 #else
-      fprintf(stderr, "Assert");
-      if (file)
-        fprintf(stderr, " in file %s:%d", file, line);
-      if (msg)
-        fprintf(stderr, " %s", msg);
-      fprintf(stderr, "\n");
+    fprintf(stderr, "Assert");
+    if (file)
+      fprintf(stderr, " in file %s:%d", file, line);
+    if (msg)
+      fprintf(stderr, " %s", msg);
+    fprintf(stderr, "\n");
 #endif // linux
-      assert(0);
-    }
+    assert(0);
     #else
-    AC_USER_DEFINED_ASSERT(condition, file, line, msg);
+    AC_USER_DEFINED_ASSERT(false, file, line, msg);
     #endif
   #endif
   }
+  // constexpr as long as the condition holds, so asserting functions still fold
+  constexpr void ac_assert(bool condition, const char *file=0, int line=0, const char *msg=0) {
+    if(!condition)
+      ac_assert_failed(file, line, msg);
+  }
+
+#ifdef DEBUG_AC_INT_STATS
+  // Overflow counts of DEBUG_AC_INT_STATS. A location claims a slot of the open addressed
+  // table with a compare and swap of its key, after that its count is only incremented,
+  // so threads never lock. The table is printed when it is destroyed at exit.
+  class overflow_stats {
+    struct slot {
+      std::atomic<Ulong> key;
+      std::atomic<Ulong> count;
+      const char *file;
+      int line;
+      int width;
+      bool sign;
+    };
+    slot slots[AC_INT_STATS_SLOTS];
+    std::atomic<Ulong> dropped;
+
+    overflow_stats() {}
+    ~overflow_stats() { report(stdout); }
+
+  public:
+    static overflow_stats &table() {
+      static overflow_stats t;
+      return t;
+    }
+
+    // true for 1 in AC_INT_STATS_SAMPLE calls at random, a fixed stride would only ever
+    // see the same assignments of a loop body
+    static bool sampled() {
+      if (AC_INT_STATS_SAMPLE <= 1)
+        return true;
+      static thread_local unsigned x = 2463534242u;
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      return x % AC_INT_STATS_SAMPLE == 0;
+    }
+
+    void record(const char *file, int line, int width, bool sign) {
+      Ulong h = (Ulong) (size_t) file * 0x9e3779b97f4a7c15ull ^ ((Ulong) line << 24 | (Ulong) width << 1 | sign);
+      h ^= h >> 29;
+      h *= 0xbf58476d1ce4e5b9ull;
+      h ^= h >> 32;
+      const Ulong key = h | 1;
+      for (int i = 0; i < AC_INT_STATS_SLOTS; i++) {
+        slot &s = slots[(h + i) % AC_INT_STATS_SLOTS];
+        Ulong k = s.key.load(std::memory_order_acquire);
+        if (k == 0) {
+          if (s.key.compare_exchange_strong(k, key, std::memory_order_acq_rel)) {
+            s.file = file;
+            s.line = line;
+            s.width = width;
+            s.sign = sign;
+            k = key;
+          }
+        }
+        if (k == key) {
+          s.count.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+      }
+      dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // one line per location and type, the most overflows first
+    void report(FILE *f) const {
+      std::vector<const slot *> v;
+      Ulong total = 0;
+      for (int i = 0; i < AC_INT_STATS_SLOTS; i++) {
+        if (slots[i].key.load() && slots[i].file) {
+          v.push_back(&slots[i]);
+          total += slots[i].count.load();
+        }
+      }
+      std::sort(v.begin(), v.end(), [](const slot *a, const slot *b) {
+        return a->count.load() != b->count.load() ? a->count.load() > b->count.load() :
+               a->line != b->line ? a->line < b->line : a->width < b->width;
+      });
+      fprintf(f, "ac_int overflow statistics (DEBUG_AC_INT_STATS): %llu overflows at %d locations",
+              (unsigned long long) total, (int) v.size());
+      if (AC_INT_STATS_SAMPLE > 1)
+        fprintf(f, ", 1 in %d assignments checked at random", (int) AC_INT_STATS_SAMPLE);
+      if (dropped.load())
+        fprintf(f, ", %llu more at locations beyond AC_INT_STATS_SLOTS", (unsigned long long) dropped.load());
+      fprintf(f, "\n");
+      for (size_t i = 0; i < v.size(); i++)
+        fprintf(f, "%12llu  %s:%d  ac_int<%d, %s>\n", (unsigned long long) v[i]->count.load(),
+                v[i]->file, v[i]->line, v[i]->width, v[i]->sign ? "true" : "false");
+      fflush(f);
+    }
+  };
+#endif
 
   // helper structs for statically computing log2 like functions (nbits, log2_floor, log2_ceil)
   //   using recursive templates
@@ -207,7 +1319,7 @@ namespace ac_private {
   };
 
   template<int N>
-  inline double ldexpr32(double d) {
+  constexpr double ldexpr32(double d) {
     double d2 = d;
     if(N < 0)
       for(int i=0; i < -N; i++)
@@ -217,19 +1329,27 @@ namespace ac_private {
         d2 *= (Ulong) 1 << 32;
     return d2;
   }
-  template<> inline double ldexpr32<0>(double d) { return d; }
-  template<> inline double ldexpr32<1>(double d) { return d * ((Ulong) 1 << 32); }
-  template<> inline double ldexpr32<-1>(double d) { return d / ((Ulong) 1 << 32); }
-  template<> inline double ldexpr32<2>(double d) { return (d * ((Ulong) 1 << 32)) * ((Ulong) 1 << 32); }
-  template<> inline double ldexpr32<-2>(double d) { return (d / ((Ulong) 1 << 32)) / ((Ulong) 1 << 32); }
+  template<> constexpr double ldexpr32<0>(double d) { return d; }
+  template<> constexpr double ldexpr32<1>(double d) { return d * ((Ulong) 1 << 32); }
+  template<> constexpr double ldexpr32<-1>(double d) { return d / ((Ulong) 1 << 32); }
+  template<> constexpr double ldexpr32<2>(double d) { return (d * ((Ulong) 1 << 32)) * ((Ulong) 1 << 32); }
+  template<> constexpr double ldexpr32<-2>(double d) { return (d / ((Ulong) 1 << 32)) / ((Ulong) 1 << 32); }
 
   template<int N>
-  inline double ldexpr(double d) {
+  constexpr double ldexpr(double d) {
     return ldexpr32<N/32>( N < 0 ? d/( (unsigned) 1 << (-N & 31)) : d * ( (unsigned) 1 << (N & 31)));
   }
 
+  // AC_BIT_CAST without __builtin_bit_cast
+  template<typename T, typename F>
+  inline T bit_cast(const F &f) {
+    T t;
+    std::memcpy(&t, &f, sizeof(t));
+    return t;
+  }
+
   template<int N>
-  inline double ldexpr1(double d) {
+  constexpr double ldexpr1(double d) {
     return  N < 0 ? d/( (unsigned) 1 << (-N)) : d * ( (unsigned) 1 << (N));
   }
 
@@ -452,6 +1572,9 @@ namespace ac_private {
   //Helper function for multiplication on x86
   template <int N1, int N2>
   constexpr ap_uint<N1 + N2> bit_multiply(ap_uint<N1> v1, ap_uint<N2> v2) {
+  #ifdef AC_INT_LIMB_BACKEND
+    return ap_uint<N1 + N2>(v1) * v2;
+  #else
     ap_uint<N1 + N2 > x1 = v1;
     ap_uint<N2 > x2 = v2;
     
@@ -464,6 +1587,7 @@ namespace ac_private {
       x2 >>= 1;                 
     }
     return r;
+  #endif
   }
 
   //Helper function for pow on x86
@@ -513,28 +1637,105 @@ namespace ac_private {
     return bit_division<N>(value, divisor, r);
   }
 
-  template <int N>
-  inline std::string to_string(ap_uint<N> value, int base) {
-    std::string buf = "";
+  // most digits of an n bit magnitude in base 2 to 16
+  constexpr int to_chars_size(int n, int base) {
+    return n / (base < 4 ? 1 : base < 8 ? 2 : base < 16 ? 3 : 4) + 1;
+  }
 
-    if (base < 2 || base > 16) return buf;
+  // the digits of value in base 2 to 16 written backwards ending at end, returns the
+  // position of the first digit
+  template <int N>
+  inline char *to_chars_backward(ap_uint<N> value, int base, char *end) {
+  #ifdef AC_INT_LIMB_BACKEND
+    Ulong m[ap_uint<N>::L];
+    for (int i = 0; i < ap_uint<N>::L; i++)
+      m[i] = value.v[i];
+    return limb_digits(m, ap_uint<N>::L, base, end);
+  #else
+    // one bit_division per chunk of digits that fits into 32 bits
+    int k = 1;
+    Ulong c0 = base;
+    for (; c0 * base <= 0xffffffffu; k++)
+      c0 *= base;
+    const ap_uint<AC_MAX(N + 1, 33)> chunk = c0;
+    ap_uint<AC_MAX(N + 1, 33)> quotient = value;
+    char *p = end;
+    do {
+      ap_uint<AC_MAX(N + 1, 33)> r = 0;
+      quotient = bit_division<AC_MAX(N + 1, 33)>(quotient, chunk, r);
+      unsigned c = (unsigned) r;
+      for (int j = 0; j < k && (quotient != 0 || c); j++) {
+        *--p = "0123456789abcdef"[c % base];
+        c /= base;
+      }
+    } while (quotient != 0);
+    if (p == end) *--p = '0';
+    return p;
+  #endif
+  }
 
-    enum { kMaxDigits = 35 };
-    buf.reserve(kMaxDigits);
+  // number of significant bits of value, 0 for 0
+  template <int N>
+  inline int bit_length(ap_uint<N> value) {
+    if (value == 0) return 0;
+    int n = 0;
+    int step = 1;
+    while (step < N) step <<= 1;
+    for (; step; step >>= 1)
+      if (n + step < N && (value >> (n + step)) != 0) n += step;
+    return n + 1;
+  }
+
+  // the digits of value formed in a buffer of SIZE characters on the stack and copied to
+  // [first, last), or a null pointer if they do not fit
+  template <int N, int SIZE>
+  inline char *to_chars_stack(char *first, char *last, ap_uint<N> value, int base) {
+    char buf[SIZE];
+    char *p = to_chars_backward<N>(value, base, buf + SIZE);
+    if (last - first < buf + SIZE - p) return 0;
+    return std::copy(p, buf + SIZE, first);
+  }
+
+  // Writes the digits of value in base 2 to 16 to [first, last), without a terminating
+  // null, and returns the end of the digits, or a null pointer if they do not fit.
+  // Nothing is written for other bases. The digits are formed in place when [first, last)
+  // has room for to_chars_size digits, and always in bases 2 and 4, whose number of digits
+  // follows from the bit length of value. Otherwise they are formed on the stack.
+  template <int N>
+  inline char *to_chars(char *first, char *last, ap_uint<N> value, int base) {
+    if (base < 2 || base > 16) return first;
+    const int size = to_chars_size(N, base);
+    if (last - first >= size) {
+      char *p = to_chars_backward<N>(value, base, first + size);
+      return p == first ? first + size : std::copy(p, first + size, first);
+    }
+    if (base == 2 || base == 4) {
+      const int digits = AC_MAX((bit_length<N>(value) + (base == 4)) / (base == 4 ? 2 : 1), 1);
+      if (last - first < digits) return 0;
+      to_chars_backward<N>(value, base, first + digits);
+      return first + digits;
+    }
+    if (base < 8) return to_chars_stack<N, N + 1>(first, last, value, base);
+    return to_chars_stack<N, N / 3 + 1>(first, last, value, base);
+  }
 
-    const int N_bits = AC_MAX(N + 1, 5);
-    ap_uint<N_bits> quotient = value;
-    int mod;
-    ap_uint<N_bits> b = base;
-    do {
-      ap_uint<N_bits> r = 0;
-      quotient = bit_division<N_bits>(quotient, b, r);
-      mod = (int)(r);
-      buf += "0123456789abcdef"[ mod ];
-    } while (quotient);
+  template <int N>
+  inline char *to_chars(char *first, char *last, ap_int<N> value, int base) {
+    ap_int<N + 1> v = value;
+    if (value < 0 && base >= 2 && base <= 16) {
+      if (first == last) return 0;
+      *first++ = '-';
+      v = -v;
+    }
+    ap_uint<N + 1> t = v;
+    return to_chars<N + 1>(first, last, t, base);
+  }
 
-    std::reverse(buf.begin(), buf.end());
-    return buf;
+  template <int N>
+  inline std::string to_string(ap_uint<N> value, int base) {
+    std::string s(to_chars_size(N, base), '0');
+    s.resize(to_chars<N>(&s[0], &s[0] + s.size(), value, base) - &s[0]);
+    return s;
   }
 
   template <int N>
@@ -544,14 +1745,48 @@ namespace ac_private {
 
   template <int N>
   inline std::string to_string(ap_int<N> value, int base) {
-    ap_int<N + 1> v = value;
-    if(value >= 0){
-      ap_uint<N + 1> t = v;
-      return to_string(t, base);
-    } else {
-      ap_uint<N + 1> t = -v;
-      return "-" + to_string(t, base);
+    std::string s(to_chars_size(N + 1, base) + 1, '0');
+    s.resize(to_chars<N>(&s[0], &s[0] + s.size(), value, base) - &s[0]);
+    return s;
+  }
+
+  // Parses the digits in base 2 to 16 at the start of [first, last) into value, no sign,
+  // and returns the end of the digits, first if there are none. overflow is set if the
+  // number does not fit N bits, value is then the number modulo 2^N.
+  template <int N>
+  inline const char *from_chars(const char *first, const char *last, ap_uint<N> &value, int base, bool &overflow) {
+    overflow = false;
+    if (base < 2 || base > 16) return first;
+  #ifdef AC_INT_LIMB_BACKEND
+    ap_uint<N> t;
+    const char *p = limb_from_chars(first, last, base, t.v, ap_uint<N>::L, ap_uint<N>::TOP, overflow);
+  #else
+    // one multiplication per chunk of digits that fits into 32 bits
+    ap_uint<N> t = 0;
+    const char *p = first;
+    while (p != last) {
+      unsigned c = 0;
+      Ulong pw = 1;
+      const char *q = p;
+      for (; q != last && pw * base <= 0xffffffffu; q++) {
+        const unsigned ch = (unsigned char) *q;
+        const unsigned d = ch - '0' < 10 ? ch - '0' : (ch | 0x20) - 'a' < 6 ? (ch | 0x20) - 'a' + 10 : 16;
+        if (d >= (unsigned) base)
+          break;
+        c = c * base + d;
+        pw *= base;
+      }
+      if (q == p)
+        break;
+      const ap_uint<N + 33> r = bit_multiply<N, 33>(t, (ap_uint<33>) pw) + c;
+      overflow = overflow || (r >> N) != 0;
+      t = r;
+      p = q;
     }
+  #endif
+    if (p != first)
+      value = t;
+    return p;
   }
 
   template<int W, bool S> struct select_type {};
@@ -567,6 +1802,66 @@ namespace ac_private {
     typedef ap_uint<W> type;
   };
 
+  // type of N bits that holds every value of both operands of a division, where ap_int
+  // would divide a negative operand as unsigned when the other is unsigned and as wide
+  template<int N1, bool S1, int N2, bool S2>
+  struct div_type {
+    enum { N = AC_MAX(N1 + (S2 && !S1), N2 + (S1 && !S2)), S = S1 || S2 };
+    typedef typename select_type<N, S>::type type;
+  };
+
+  // Array divider for synthesis, one row per quotient bit. A restoring row compares the
+  // partial remainder with the divisor and subtracts it if not smaller, a non-restoring
+  // row adds or subtracts the divisor by the sign of the partial remainder and saves the
+  // comparator, with a single correction at the end. Pipeline registers are inserted
+  // after every ceil(N / STAGES) rows. A zero divisor gives a quotient of all ones.
+  template<int N, int STAGES, bool NON_RESTORING>
+  constexpr void ap_array_udiv(ap_uint<N> num, ap_uint<N> den, ap_uint<N> &quo, ap_uint<N> &rem) {
+    const int ROWS = (N + STAGES - 1) / STAGES;
+    // the dividend is shifted out at the top of q while the quotient bits enter at the bottom
+    ap_uint<N> q = num;
+    ap_int<N + 2> r = 0;
+    ap_int<N + 2> d = den;
+  #pragma unroll
+    for (int i = 0; i < N; i++) {
+      const bool top = ((q >> (N - 1)) & 1) != 0;
+      bool qbit = false;
+      if (NON_RESTORING) {
+        r = r < 0 ? ((r << 1) | top) + d : ((r << 1) | top) - d;
+        qbit = r >= 0;
+      } else {
+        r = (r << 1) | top;
+        qbit = r >= d;
+        if (qbit) r -= d;
+      }
+      q = (q << 1) | qbit;
+      if (STAGES > 1 && (i + 1) % ROWS == 0 && i + 1 < N) {
+        q = AC_DIV_REG(q);
+        r = AC_DIV_REG(r);
+        d = AC_DIV_REG(d);
+      }
+    }
+    if (NON_RESTORING && r < 0) r += d;
+    quo = q;
+    rem = r;
+  }
+
+  // Quotient truncated towards zero and remainder with the sign of the dividend, of
+  // operands of type select_type<N,S>::type
+  template<int N, bool S, int STAGES, bool NON_RESTORING>
+  constexpr void ap_array_div(typename select_type<N,S>::type a, typename select_type<N,S>::type b,
+                              typename select_type<N,S>::type &quo, typename select_type<N,S>::type &rem) {
+    const bool na = S && a < 0, nb = S && b < 0;
+    ap_uint<N> ua = a, ub = b, uq = 0, ur = 0;
+    if (na) ua = -ua;
+    if (nb) ub = -ub;
+    ap_array_udiv<N, STAGES, NON_RESTORING>(ua, ub, uq, ur);
+    quo = uq;
+    rem = ur;
+    if (na != nb) quo = -quo;
+    if (na) rem = -rem;
+  }
+
   //////////////////////////////////////////////////////////////////////////////
   //  Integer Vector class: iv
   //////////////////////////////////////////////////////////////////////////////
@@ -605,19 +1900,68 @@ namespace ac_private {
     constexpr Ulong to_uint64() const {
       return (Ulong) value;
     }
+  #ifdef AC_INT_LIMB_BACKEND
+    __HLS_CONSTEXPR__ double to_double() const {
+      if (actype::L == 1)
+        return S ? (double) (Slong) value.v[0] : (double) value.v[0];
+      return ac_private::limb_to_double<actype::L>(value.v, value.is_neg());
+    }
+  #else
     inline double to_double() const {
       volatile Slong t = (Slong) value;
       return (double) (t);
     }
+  #endif
 
     std::string to_string(ac_base_mode mode) const {
       return ac_private::to_string<N>(value, mode);
     }
+    char *to_chars(char *first, char *last, ac_base_mode mode) const {
+      return ac_private::to_chars<N>(first, last, value, mode);
+    }
+    const char *from_chars(const char *first, const char *last, ac_base_mode mode, bool &overflow) {
+      const bool neg = first != last && *first == '-';
+      ap_uint<N + 1> m = 0;
+      const char *p = ac_private::from_chars<N + 1>(first + neg, last, m, mode, overflow);
+      if (p == first + neg) return first;
+      if (S)
+        overflow = overflow || m > (ap_uint<N + 1>(1) << (N - 1)) - (neg ? 0 : 1);
+      else
+        overflow = overflow || (m >> N) != 0 || (neg && m != 0);
+      value = neg ? (ap_uint<N + 1>) -m : m;
+      return p;
+    }
+    void from_bytes(const unsigned char *p, bool bigendian) {
+    #ifdef AC_INT_LIMB_BACKEND
+      Ulong m[(N + 7) / 64 + 1];
+      ac_private::limb_from_bytes(p, (N + 7) / 8, bigendian, m);
+      for (int i = 0; i < actype::L; i++)
+        value.v[i] = m[i];
+      value.normalize();
+    #else
+      ap_uint<(N + 7) / 8 * 8> t = 0;
+      for (int i = 0; i < (N + 7) / 8; i++)
+        t = (t << 8) | p[bigendian ? i : (N + 7) / 8 - 1 - i];
+      value = t;
+    #endif
+    }
+    void to_bytes(unsigned char *p, bool bigendian) const {
+    #ifdef AC_INT_LIMB_BACKEND
+      ac_private::limb_to_bytes(value.v, (N + 7) / 8, bigendian, p);
+    #else
+      ap_int<(N + 7) / 8 * 8> t = value;
+      for (int i = 0; i < (N + 7) / 8; i++)
+        p[bigendian ? (N + 7) / 8 - 1 - i : i] = (unsigned char) (t >> (8 * i));
+    #endif
+    }
 
     //BEGIN: debug functions for X86 flow
     template<int N2, bool S2>
-    __HLS_CONSTEXPR__ void debug_within_range(const iv<N2, S2> &op2){
+    __HLS_CONSTEXPR__ void debug_within_range(const iv<N2, S2> &op2 AC_INT_SRC_LOC){
     #if !defined(__HLS_USE_CONSTEXPR__)
+      #ifdef DEBUG_AC_INT_STATS
+      if(N2 + 1 <= N || !overflow_stats::sampled()) return ;
+      #endif
       enum {Nx = AC_MAX(N, N2 + 1) };
       ap_int<N2 + 1> v = op2.value;
       if(N2 + 1 <= N) return ;
@@ -630,6 +1974,10 @@ namespace ac_private {
       else{
         if(ap_equal_zeros_from<N, N2 + 1>(v)) return ;
       }
+      #ifdef DEBUG_AC_INT_STATS
+      overflow_stats::table().record(ac_src_file, ac_src_line, N, S);
+      return ;
+      #endif
       #if defined (__linux__)
       std::cout << "warning: overflow, assign value " \
       << ac_private::to_string(v, 10) \
@@ -646,12 +1994,12 @@ namespace ac_private {
     #endif 
     }
 
-    __HLS_CONSTEXPR__ void debug_within_range(Ulong v){
-      debug_within_range(iv<64, false>(v));
+    __HLS_CONSTEXPR__ void debug_within_range(Ulong v AC_INT_SRC_LOC){
+      debug_within_range(iv<64, false>(v) AC_INT_SRC_LOC_ARGS);
     }
 
-    __HLS_CONSTEXPR__ void debug_within_range(Slong v){
-      debug_within_range(iv<64, true>(v));
+    __HLS_CONSTEXPR__ void debug_within_range(Slong v AC_INT_SRC_LOC){
+      debug_within_range(iv<64, true>(v) AC_INT_SRC_LOC_ARGS);
     }
     //END
 
@@ -665,8 +2013,10 @@ namespace ac_private {
 
     template<int N2, bool S2, int Nr, bool Sr>
     constexpr void mult(const iv<N2, S2> &op2, iv<Nr, Sr> &r) const {
+    #ifndef AC_INT_LIMB_BACKEND
       ACINT_STATIC_ASSERT(N2 <= 512);
       ACINT_STATIC_ASSERT(Nr <= 512);
+    #endif
       r.value = value;
       r.value *= op2.value;
     }
@@ -680,20 +2030,51 @@ namespace ac_private {
       r.value = value;
       r.value -= op2.value;
     }
+    // The dividend is taken in the type of r (which holds every quotient), both operands
+    // are divided in their div_type.
     template<int N2, bool S2, int Nr, bool Sr>
     constexpr void div(const iv<N2, S2> &op2, iv<Nr, Sr> &r) const {
-      ACINT_STATIC_ASSERT(N2 <= 64);
-      ACINT_STATIC_ASSERT(Nr <= 64);
-      typedef typename select_type<N2,S2>::type adivtype;
+    #ifndef AC_INT_LIMB_BACKEND
+      if (div_type<Nr, Sr, N2, S2>::N > 64) {
+        iv<N2 + 1, true> m = 0;
+        array_divide<AC_INT_DIV_STAGES, AC_INT_DIV_ALGORITHM == AC_DIV_NON_RESTORING>(op2, r, m);
+        return;
+      }
+    #endif
+      typedef typename div_type<Nr, Sr, N2, S2>::type ctype;
       typedef typename select_type<Nr,Sr>::type bdivtype;
-      adivtype a = op2.value;
       bdivtype b = value;
-      r.value = b/a;
+      r.value = ctype(b) / ctype(op2.value);
     }
+    // The remainder is narrowed to r only after dividing in the div_type of both operands.
     template<int N2, bool S2, int Nr, bool Sr>
     constexpr void rem(const iv<N2, S2> &op2, iv<Nr, Sr> &r) const {
-      r.value = value;
-      r.value %= op2.value;
+    #ifndef AC_INT_LIMB_BACKEND
+      if (div_type<N, S, N2, S2>::N > 64) {
+        iv<N, S> q = 0;
+        array_divide<AC_INT_DIV_STAGES, AC_INT_DIV_ALGORITHM == AC_DIV_NON_RESTORING>(op2, q, r);
+        return;
+      }
+    #endif
+      typedef typename div_type<N, S, N2, S2>::type ctype;
+      r.value = ctype(value) % ctype(op2.value);
+    }
+    // q = value / op2 as for div into q, and the remainder of that division. The dividend
+    // is taken in the type of q and divided in the div_type of q and op2.
+    // An array divider (ap_array_udiv) with the vendor backend, the limb division otherwise.
+    template<int STAGES, bool NON_RESTORING, int N2, bool S2, int Nq, bool Sq, int Nm, bool Sm>
+    constexpr void array_divide(const iv<N2, S2> &op2, iv<Nq, Sq> &q, iv<Nm, Sm> &m) const {
+      enum { Nc = div_type<Nq, Sq, N2, S2>::N, Sc = div_type<Nq, Sq, N2, S2>::S };
+      typedef typename select_type<Nc, Sc>::type ctype;
+      const typename select_type<Nq, Sq>::type b = value;
+      ctype qc = 0, rc = 0;
+    #ifdef AC_INT_LIMB_BACKEND
+      qc = ctype::divmod(ctype(b), ctype(op2.value), rc);
+    #else
+      ap_array_div<Nc, Sc, STAGES, NON_RESTORING>(b, op2.value, qc, rc);
+    #endif
+      q.value = qc;
+      m.value = rc;
     }
     constexpr void increment() {
       value += 1;
@@ -858,17 +2239,17 @@ namespace ac_private {
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wshift-count-overflow"
     template<int N2, bool S2>
-    void set_slc(unsigned lsb, int WS, const iv<N2, S2> &op2) {
+    constexpr void set_slc(unsigned lsb, int WS, const iv<N2, S2> &op2) {
       AC_ASSERT(N2<=N, "Bad usage: WS greater than length of slice");
       if(N2 == N){
         value = op2.value;
       }
       else if (N2 <= N) {
-        iv<N,S> temp;
+        iv<N,S> temp = 0;
         temp.value = (actype) op2.value;
         temp.value <<= lsb;
         // Compute AND mask
-        iv<N,S> mask;
+        iv<N,S> mask = 0;
         mask.value = 1;
         mask.value <<= N2;
         mask.value -= 1;
@@ -1325,43 +2706,43 @@ public:
     #endif
   }
   template<int W2, bool S2>
-  __HLS_CONSTEXPR__ inline ac_int (const ac_int<W2,S2> &op) : ConvBase(op) {
-    Base::debug_within_range(op);
+  __HLS_CONSTEXPR__ inline ac_int (const ac_int<W2,S2> &op AC_INT_SRC_LOC) : ConvBase(op) {
+    Base::debug_within_range(op AC_INT_SRC_LOC_ARGS);
   }
 
   __HLS_CONSTEXPR__ inline ac_int( bool b ) : ConvBase(b) { }
-  __HLS_CONSTEXPR__ inline ac_int( char b ) : ConvBase(b) {
-    Base::debug_within_range(Ulong(b));
+  __HLS_CONSTEXPR__ inline ac_int( char b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(Ulong(b) AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int(signed char b) : ConvBase(b) {
-    Base::debug_within_range(Slong(b));
+  __HLS_CONSTEXPR__ inline ac_int(signed char b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(Slong(b) AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int(unsigned char b) : ConvBase(b) {
-    Base::debug_within_range(Ulong(b));
+  __HLS_CONSTEXPR__ inline ac_int(unsigned char b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(Ulong(b) AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int(signed short b) : ConvBase(b) {
-    Base::debug_within_range(Slong(b));
+  __HLS_CONSTEXPR__ inline ac_int(signed short b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(Slong(b) AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int(unsigned short b) : ConvBase(b) {
-    Base::debug_within_range(Ulong(b));
+  __HLS_CONSTEXPR__ inline ac_int(unsigned short b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(Ulong(b) AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int(signed int b) : ConvBase(b) {
-    Base::debug_within_range(Slong(b));
+  __HLS_CONSTEXPR__ inline ac_int(signed int b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(Slong(b) AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int( unsigned int b ) : ConvBase(b) {
-    Base::debug_within_range(Ulong(b));
+  __HLS_CONSTEXPR__ inline ac_int( unsigned int b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(Ulong(b) AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int( signed long b ) : ConvBase(b) {
-    Base::debug_within_range(Slong(b));
+  __HLS_CONSTEXPR__ inline ac_int( signed long b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(Slong(b) AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int( unsigned long b ) : ConvBase(b) {
-    Base::debug_within_range(Ulong(b));
+  __HLS_CONSTEXPR__ inline ac_int( unsigned long b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(Ulong(b) AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int( Slong b ) : ConvBase(b) {
-    Base::debug_within_range(b);
+  __HLS_CONSTEXPR__ inline ac_int( Slong b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(b AC_INT_SRC_LOC_ARGS);
   }
-  __HLS_CONSTEXPR__ inline ac_int( Ulong b ) : ConvBase(b) {
-    Base::debug_within_range(b);
+  __HLS_CONSTEXPR__ inline ac_int( Ulong b AC_INT_SRC_LOC) : ConvBase(b) {
+    Base::debug_within_range(b AC_INT_SRC_LOC_ARGS);
   }
   constexpr ac_int(double d) : ConvBase(d) {}
 
@@ -1405,13 +2786,38 @@ public:
   constexpr unsigned long to_ulong() const { return (unsigned long) Base::value; }
   constexpr Slong to_int64() const { return Base::to_int64(); }
   constexpr Ulong to_uint64() const { return Base::to_uint64(); }
-  inline double to_double() const { return Base::to_double(); }
+  __HLS_CONSTEXPR__ double to_double() const { return Base::to_double(); }
 
   constexpr int length() const { return W; }
 
   inline std::string to_string(ac_base_mode base_rep, bool sign_mag = false) const {
     return Base::to_string(base_rep);
   }
+  // Writes the digits to [first, last) like std::to_chars, without a terminating null,
+  // and returns the end of the digits, or a null pointer if the buffer is too small.
+  // W + 2 characters always suffice, W / 3 + 3 for AC_DEC and W / 4 + 3 for AC_HEX.
+  inline char *to_chars(char *first, char *last, ac_base_mode base_rep = AC_DEC) const {
+    return Base::to_chars(first, last, base_rep);
+  }
+  // Parses digits in base_rep with an optional leading '-', as written by to_chars, from the
+  // start of [first, last) and returns the end of them like std::from_chars, or first (and
+  // leaves the value) if there are none. A number out of range wraps modulo 2^W and sets
+  // overflow. No memory is allocated.
+  inline const char *from_chars(const char *first, const char *last, ac_base_mode base_rep, bool &overflow) {
+    return Base::from_chars(first, last, base_rep, overflow);
+  }
+  inline const char *from_chars(const char *first, const char *last, ac_base_mode base_rep = AC_DEC) {
+    bool overflow = false;
+    return Base::from_chars(first, last, base_rep, overflow);
+  }
+  // Reads and writes the value as (W + 7) / 8 bytes, least significant byte first unless
+  // bigendian. from_bytes ignores the bits above W, to_bytes sign or zero extends to them.
+  inline void from_bytes(const unsigned char *p, bool bigendian = false) {
+    Base::from_bytes(p, bigendian);
+  }
+  inline void to_bytes(unsigned char *p, bool bigendian = false) const {
+    Base::to_bytes(p, bigendian);
+  }
 
   inline static std::string type_name() {
     const char *tf[] = {",false>", ",true>"};
@@ -1452,6 +2858,12 @@ public:
     Base::rem(op2, r);
     return r;
   }
+  // quo = *this / op2 and rem its remainder, from an array divider of ALG with STAGES
+  // pipeline stages in synthesis. rem equals *this % op2.
+  template<int STAGES, ac_div_algorithm ALG, int W2, bool S2>
+  __HLS_CONSTEXPR__ void divide(const ac_int<W2,S2> &op2, typename rt<W2,S2>::div &quo, typename rt<W2,S2>::mod &rem) const {
+    Base::template array_divide<STAGES, ALG == AC_DIV_NON_RESTORING>(op2, quo, rem);
+  }
 
   template<int W2, bool S2>
   __HLS_CONSTEXPR__ void check_overflow(const ac_int<W2, S2> &op2, ac_debug_op debug_op){
@@ -1714,7 +3126,7 @@ public:
 
   // Bit and Slice Select -----------------------------------------------------
   template<int WS, int WX, bool SX>
-  inline ac_int<WS,S> slc(const ac_int<WX,SX> &index) const {
+  __HLS_CONSTEXPR__ ac_int<WS,S> slc(const ac_int<WX,SX> &index) const {
     ac_int<W, S> op = *this;
     ac_int<WS, S> r = 0;
     AC_ASSERT(index >= 0, "Attempting to read slc with negative indeces");
@@ -1725,7 +3137,7 @@ public:
   }
 
   template<int WS>
-  inline ac_int<WS,S> slc(signed index) const {
+  __HLS_CONSTEXPR__ ac_int<WS,S> slc(signed index) const {
     ac_int<W, S> op = *this;
     ac_int<WS,S> r = 0;
     AC_ASSERT(index >= 0, "Attempting to read slc with negative indeces");
@@ -1735,7 +3147,7 @@ public:
     return r;
   }
   template<int WS>
-  inline ac_int<WS,S> slc(unsigned uindex) const {
+  __HLS_CONSTEXPR__ ac_int<WS,S> slc(unsigned uindex) const {
     ac_int<W,S> op = *this;
     Base::shift_r(uindex, op);
     ac_int<WS,S> r = op;
@@ -1743,7 +3155,7 @@ public:
   }
 
   template<int W2, bool S2, int WX, bool SX>
-  inline ac_int &set_slc(const ac_int<WX,SX> lsb, const ac_int<W2,S2> &slc) {
+  __HLS_CONSTEXPR__ ac_int &set_slc(const ac_int<WX,SX> lsb, const ac_int<W2,S2> &slc) {
     AC_ASSERT(lsb.to_int() + W2 <= W && lsb.to_int() >= 0, "Out of bounds set_slc");
     if (lsb.to_int() + W2 <= W && lsb.to_int() >= 0) {
         ac_int<WX-SX, false> ulsb = lsb;
@@ -1755,7 +3167,7 @@ public:
     return *this;
   }
   template<int W2, bool S2>
-  inline ac_int &set_slc(signed lsb, const ac_int<W2,S2> &slc) {
+  __HLS_CONSTEXPR__ ac_int &set_slc(signed lsb, const ac_int<W2,S2> &slc) {
     AC_ASSERT(lsb + W2 <= W && lsb >= 0, "Out of bounds set_slc");
     if (lsb + W2 <= W && lsb >= 0) {
         unsigned ulsb = lsb & ((unsigned)~0 >> 1);
@@ -1767,7 +3179,7 @@ public:
     return *this;
   }
   template<int W2, bool S2>
-  inline ac_int &set_slc(unsigned ulsb, const ac_int<W2,S2> &slc) {
+  __HLS_CONSTEXPR__ ac_int &set_slc(unsigned ulsb, const ac_int<W2,S2> &slc) {
     AC_ASSERT(ulsb + W2 <= W, "Out of bounds set_slc");
     if (ulsb + W2 <= W) {
         Base::set_slc(ulsb, W2, (ac_int<W2,false>) slc);
@@ -1782,16 +3194,16 @@ public:
     ac_int &d_bv;
     unsigned d_index;
   public:
-    ac_bitref( ac_int *bv, unsigned index=0 ) : d_bv(*bv), d_index(index) {
+    __HLS_CONSTEXPR__ ac_bitref( ac_int *bv, unsigned index=0 ) : d_bv(*bv), d_index(index) {
     }
-    operator bool () const {
+    __HLS_CONSTEXPR__ operator bool () const {
       return (d_index < W) ? (bool)(d_bv.value>>(d_index) & 1) : 0;
     }
 
     template<int W2, bool S2>
-    operator ac_int<W2,S2> () const { return operator bool (); }
+    __HLS_CONSTEXPR__ operator ac_int<W2,S2> () const { return operator bool (); }
 
-    inline ac_bitref operator = ( int val ) {
+    __HLS_CONSTEXPR__ ac_bitref operator = ( int val ) {
       // lsb of int (val&1) is written to bit
       if(d_index < W) {
         ac_private::ap_int<W+1> temp1 = d_bv.value;
@@ -1806,20 +3218,20 @@ public:
       return *this;
     }
     template<int W2, bool S2>
-    inline ac_bitref operator = ( const ac_int<W2,S2> &val ) {
+    __HLS_CONSTEXPR__ ac_bitref operator = ( const ac_int<W2,S2> &val ) {
       return operator =(val.to_int());
     }
-    inline ac_bitref operator = ( const ac_bitref &val ) {
+    __HLS_CONSTEXPR__ ac_bitref operator = ( const ac_bitref &val ) {
       return operator =((int) (bool) val);
     }
   };
 
-  ac_bitref operator [] ( unsigned int uindex) {
+  __HLS_CONSTEXPR__ ac_bitref operator [] ( unsigned int uindex) {
     AC_ASSERT(uindex < W, "Attempting to read bit beyond MSB");
     ac_bitref bvh( this, uindex );
     return bvh;
   }
-  ac_bitref operator [] ( int index) {
+  __HLS_CONSTEXPR__ ac_bitref operator [] ( int index) {
     AC_ASSERT(index >= 0, "Attempting to read bit with negative index");
     AC_ASSERT(index < W, "Attempting to read bit beyond MSB");
     unsigned uindex = index & ((unsigned)~0 >> 1);
@@ -1827,29 +3239,29 @@ public:
     return bvh;
   }
   template<int W2, bool S2>
-  ac_bitref operator [] ( const ac_int<W2,S2> &index) {
+  __HLS_CONSTEXPR__ ac_bitref operator [] ( const ac_int<W2,S2> &index) {
     AC_ASSERT(index >= 0, "Attempting to read bit with negative index");
     AC_ASSERT(index < W, "Attempting to read bit beyond MSB");
     ac_int<W2-S2,false> uindex = index;
     ac_bitref bvh( this, uindex.to_uint() );
     return bvh;
   }
-  bool operator [] ( unsigned int uindex) const {
+  __HLS_CONSTEXPR__ bool operator [] ( unsigned int uindex) const {
     AC_ASSERT(uindex < W, "Attempting to read bit beyond MSB");
-    return (uindex < W) ? (Base::v[uindex>>5]>>(uindex&31) & 1) : 0;
+    return (uindex < W) ? (bool)(Base::value>>uindex & 1) : 0;
   }
-  bool operator [] ( int index) const {
+  __HLS_CONSTEXPR__ bool operator [] ( int index) const {
     AC_ASSERT(index >= 0, "Attempting to read bit with negative index");
     AC_ASSERT(index < W, "Attempting to read bit beyond MSB");
     unsigned uindex = index & ((unsigned)~0 >> 1);
-    return (uindex < W) ? (Base::v[uindex>>5]>>(uindex&31) & 1) : 0;
+    return (uindex < W) ? (bool)(Base::value>>uindex & 1) : 0;
   }
   template<int W2, bool S2>
-  bool operator [] ( const ac_int<W2,S2> &index) const {
+  __HLS_CONSTEXPR__ bool operator [] ( const ac_int<W2,S2> &index) const {
     AC_ASSERT(index >= 0, "Attempting to read bit with negative index");
     AC_ASSERT(index < W, "Attempting to read bit beyond MSB");
     ac_int<W2-S2,false> uindex = index;
-    return (uindex < W) ? (Base::v[uindex>>5]>>(uindex.to_uint()&31) & 1) : 0;
+    return (uindex < W) ? (bool)(Base::value>>uindex.to_uint() & 1) : 0;
   }
   typename rt_unary::leading_sign leading_sign() const {
     unsigned ls = 0;
@@ -2105,6 +3517,47 @@ namespace ac {
     return res;
   }
 
+  // Bulk conversion of n values of T (ac_int or ac_fixed) from and to a raw buffer of
+  // (T::width + 7) / 8 bytes per value, returns the end of the bytes read or written
+  template<typename T>
+  inline const unsigned char *from_bytes(const unsigned char *first, T *dst, int n, bool bigendian=false) {
+    enum { B = (T::width + 7) / 8 };
+    for (int i = 0; i < n; i++, first += B)
+      dst[i].from_bytes(first, bigendian);
+    return first;
+  }
+
+  template<typename T>
+  inline unsigned char *to_bytes(const T *src, int n, unsigned char *out, bool bigendian=false) {
+    enum { B = (T::width + 7) / 8 };
+    for (int i = 0; i < n; i++, out += B)
+      src[i].to_bytes(out, bigendian);
+    return out;
+  }
+
+  // Lookup table of N values computed at compile time, see make_table
+  template<typename T, int N>
+  struct table {
+    T v[N];
+    static const int size = N;
+    constexpr const T &operator [] (int i) const { return v[i]; }
+    constexpr T &operator [] (int i) { return v[i]; }
+  };
+
+  template<int N, typename G, std::size_t... I>
+  constexpr table<decltype(std::declval<G &>()(0)), N> make_table(G &gen, std::index_sequence<I...>) {
+    return { { gen((int) I)... } };
+  }
+
+  // returns the table gen(0) .. gen(N-1), a constant expression when gen is a constexpr function
+  // or function object (lambdas from C++17 on), so it can initialize a ROM:
+  //   constexpr ac_int<8,false> sq(int i) { return ac_int<16,false>(i * i) >> 8; }
+  //   hls_init_on_powerup static const ac::table<ac_int<8,false>,256> sq_rom = ac::make_table<256>(sq);
+  template<int N, typename G>
+  constexpr table<decltype(std::declval<G &>()(0)), N> make_table(G gen) {
+    return make_table<N>(gen, std::make_index_sequence<N>());
+  }
+
 }  // ac namespace
 
 //  Mixed Operators with Pointers  -----------------------------------------------
@@ -2311,6 +3764,15 @@ SPECIAL_VAL_FOR_INTS(Ulong, 64, false)
 
 namespace ac {
 // PUBLIC FUNCTIONS
+// Division with a configurable divider, see ac_int::divide
+//   ac::divide<4, AC_DIV_NON_RESTORING>(a, b, q, r);
+  template<int STAGES = 1, ac_div_algorithm ALG = AC_DIV_RESTORING, int W1, bool S1, int W2, bool S2>
+  inline void divide(const ac_int<W1,S1> &num, const ac_int<W2,S2> &den,
+                     typename ac_int<W1,S1>::template rt<W2,S2>::div &quo,
+                     typename ac_int<W1,S1>::template rt<W2,S2>::mod &rem) {
+    num.template divide<STAGES, ALG>(den, quo, rem);
+  }
+
 // function to initialize (or uninitialize) arrays
   template<ac_special_val V, int W, bool S>
   inline bool init_array(ac_int<W,S> *a, int n) {
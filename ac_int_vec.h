@@ -0,0 +1,281 @@
+#ifndef __HLS_AC_INT_VEC_H__
+#define __HLS_AC_INT_VEC_H__
+
+#include "HLS/hls.h"
+#include "HLS/ac_int.h"
+#include <stdint.h>
+#include <type_traits>
+
+// This is template library for short vectors of ac_int. ac_int_vec<W,S,N> holds N lanes of ac_int<W,S>
+// and provides element-wise arithmetic, compare and select, and reductions over the lanes.
+//
+// template arguments
+//			- W, S                    - Width and signedness of the lanes, as for ac_int<W,S>
+//			- N                       - Number of lanes
+//
+// operations
+//			- a + b, a - b, a * b, -a - Element-wise, the results wrap to W bits like ac_int<W,S>::operator +=
+//			- a & b, a | b, a ^ b, ~a - Element-wise bitwise operations
+//			- a << k, a >> k          - Every lane shifted by the same k, as ac_int<W,S> << k and >> k
+//			- a == b, a < b, ...      - Element-wise compares, giving a mask ac_int_vec<1,false,N>
+//			- select(m, a, b)         - Lane i is a[i] where m[i] is set and b[i] elsewhere
+//			- reduce_add()            - Sum of the lanes, ac_int<W,S>::rt_unary::set<N>::sum so it cannot overflow
+//			- reduce_min(), reduce_max(), reduce_and(), reduce_or(), reduce_xor()
+//			- v[i], v.set(i, x)       - Read and write lane i
+//			- load(p), store(p)       - Copy N lanes from and to an array of ac_int<W,S>
+//
+// example - clip and sum 64 lanes of 5 bit values:
+//			ac_int<5,false> x[64];
+//			ac_int_vec<5,false,64> v = ac_int_vec<5,false,64>::load(x);
+//			v = select(v > ac_int<5,false>(20), ac_int_vec<5,false,64>(20), v);
+//			ac_int<11,false> sum = v.reduce_add();
+//
+// In synthesis every lane is an ac_int<W,S> and every operation is an unrolled loop over the lanes, so
+// N copies of the operator are built. Reductions are balanced trees of log2(N) levels.
+//
+// x86 emulation
+//			When HLS_X86 is defined lanes of up to 64 bits are held in the smallest built-in integer that fits
+//			W bits, and the loops over the lanes are left to the vectorizer, so they compile to packed SSE,
+//			AVX2 or AVX-512 instructions depending on the target options (e.g. -march=native). The results
+//			are the same as with ac_int lanes.
+
+#ifdef HLS_X86
+#if defined(__clang__)
+#define AC_INT_VEC_LANES _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__)
+#define AC_INT_VEC_LANES _Pragma("GCC ivdep")
+#else
+#define AC_INT_VEC_LANES
+#endif
+#else
+#define AC_INT_VEC_LANES _Pragma("unroll")
+#endif
+
+namespace ac_int_vec_internal {
+	// Lane operations on ac_int<W,S>, assigning the result truncates it to W bits
+	template<int W, bool S, bool NATIVE>
+	struct lane {
+		typedef ac_int<W, S> type;
+		static type from_ac(const ac_int<W, S> &x) { return x; }
+		static ac_int<W, S> to_ac(const type &x) { return x; }
+		static type add(const type &a, const type &b) { return type(a + b); }
+		static type sub(const type &a, const type &b) { return type(a - b); }
+		static type mul(const type &a, const type &b) { return type(a * b); }
+		static type neg(const type &a) { return type(-a); }
+		static type shl(const type &a, int k) { return a << k; }
+		static type shr(const type &a, int k) { return a >> k; }
+	};
+
+	// Lane operations on the smallest built-in integer of at least W bits. The operations are done in
+	// unsigned arithmetic of at least 32 bits and the results sign or zero extended from bit W-1.
+	template<int W, bool S>
+	struct lane<W, S, true> {
+		typedef typename std::conditional<(W <= 8), uint8_t,
+		        typename std::conditional<(W <= 16), uint16_t,
+		        typename std::conditional<(W <= 32), uint32_t, uint64_t>::type>::type>::type utype;
+		typedef typename std::conditional<S, typename std::make_signed<utype>::type, utype>::type type;
+		typedef typename std::conditional<(sizeof(utype) < 4), uint32_t, utype>::type calc;
+		enum { CB = sizeof(calc) * 8 };
+
+		static type wrap(calc x) {
+			if (W == CB) {
+				return (type) x;
+			}
+			if (S) {
+				return (type) ((typename std::make_signed<calc>::type) (x << (CB - W) % CB) >> (CB - W) % CB);
+			}
+			return (type) (x & (((calc) 1 << W % CB) - 1));
+		}
+		static type from_ac(const ac_int<W, S> &x) { return (type) (S ? (Ulong) x.to_int64() : x.to_uint64()); }
+		static ac_int<W, S> to_ac(type x) { return ac_int<W, S>(x); }
+		static type add(type a, type b) { return wrap((calc) a + (calc) b); }
+		static type sub(type a, type b) { return wrap((calc) a - (calc) b); }
+		static type mul(type a, type b) { return wrap((calc) a * (calc) b); }
+		static type neg(type a) { return wrap((calc) 0 - (calc) a); }
+		static type shl(type a, int k) { return k < W ? wrap((calc) a << k) : (type) 0; }
+		static type shr(type a, int k) { return (type) (a >> (k < W ? k : (S ? W - 1 : 0))) & (type) (S || k < W ? ~(utype) 0 : 0); }
+	};
+}
+
+template<int W, bool S, int N>
+class ac_int_vec {
+#ifdef HLS_X86
+	typedef ac_int_vec_internal::lane<W, S, (W <= 64)> lane;
+#else
+	typedef ac_int_vec_internal::lane<W, S, false> lane;
+#endif
+	typedef typename lane::type lane_t;
+	lane_t v[N];
+
+	template<int W2, bool S2, int N2> friend class ac_int_vec;
+	template<int W2, bool S2, int N2>
+	friend ac_int_vec<W2, S2, N2> select(const ac_int_vec<1, false, N2> &m, const ac_int_vec<W2, S2, N2> &a, const ac_int_vec<W2, S2, N2> &b);
+
+public:
+	typedef ac_int<W, S> elem_type;
+	typedef ac_int_vec<1, false, N> mask_type;
+	typedef typename ac_int<W, S>::rt_unary::template set<N>::sum sum_type;
+	static const int lanes = N;
+
+	ac_int_vec() {}
+	// every lane set to x
+	ac_int_vec(const ac_int<W, S> &x) {
+		const lane_t t = lane::from_ac(x);
+		AC_INT_VEC_LANES
+		for (int i = 0; i < N; i++) {
+			v[i] = t;
+		}
+	}
+
+	static ac_int_vec load(const ac_int<W, S> *p) {
+		ac_int_vec r;
+		AC_INT_VEC_LANES
+		for (int i = 0; i < N; i++) {
+			r.v[i] = lane::from_ac(p[i]);
+		}
+		return r;
+	}
+	void store(ac_int<W, S> *p) const {
+		AC_INT_VEC_LANES
+		for (int i = 0; i < N; i++) {
+			p[i] = lane::to_ac(v[i]);
+		}
+	}
+	ac_int<W, S> operator[](int i) const { return lane::to_ac(v[i]); }
+	void set(int i, const ac_int<W, S> &x) { v[i] = lane::from_ac(x); }
+
+#define AC_INT_VEC_BIN_OP(OP, EXPR) \
+	ac_int_vec operator OP(const ac_int_vec &o) const { \
+		ac_int_vec r; \
+		AC_INT_VEC_LANES \
+		for (int i = 0; i < N; i++) { \
+			const lane_t a = v[i], b = o.v[i]; \
+			r.v[i] = EXPR; \
+		} \
+		return r; \
+	} \
+	ac_int_vec &operator OP##=(const ac_int_vec &o) { return *this = *this OP o; }
+
+	AC_INT_VEC_BIN_OP(+, lane::add(a, b))
+	AC_INT_VEC_BIN_OP(-, lane::sub(a, b))
+	AC_INT_VEC_BIN_OP(*, lane::mul(a, b))
+	AC_INT_VEC_BIN_OP(&, (lane_t) (a & b))
+	AC_INT_VEC_BIN_OP(|, (lane_t) (a | b))
+	AC_INT_VEC_BIN_OP(^, (lane_t) (a ^ b))
+#undef AC_INT_VEC_BIN_OP
+
+	ac_int_vec operator-() const {
+		ac_int_vec r;
+		AC_INT_VEC_LANES
+		for (int i = 0; i < N; i++) {
+			r.v[i] = lane::neg(v[i]);
+		}
+		return r;
+	}
+	ac_int_vec operator~() const { return *this ^ ac_int_vec(~ac_int<W, S>(0)); }
+	ac_int_vec operator<<(int k) const {
+		ac_int_vec r;
+		AC_INT_VEC_LANES
+		for (int i = 0; i < N; i++) {
+			r.v[i] = lane::shl(v[i], k);
+		}
+		return r;
+	}
+	ac_int_vec operator>>(int k) const {
+		ac_int_vec r;
+		AC_INT_VEC_LANES
+		for (int i = 0; i < N; i++) {
+			r.v[i] = lane::shr(v[i], k);
+		}
+		return r;
+	}
+	ac_int_vec &operator<<=(int k) { return *this = *this << k; }
+	ac_int_vec &operator>>=(int k) { return *this = *this >> k; }
+
+#define AC_INT_VEC_REL_OP(OP) \
+	mask_type operator OP(const ac_int_vec &o) const { \
+		mask_type r; \
+		AC_INT_VEC_LANES \
+		for (int i = 0; i < N; i++) { \
+			r.v[i] = v[i] OP o.v[i]; \
+		} \
+		return r; \
+	}
+
+	AC_INT_VEC_REL_OP(==)
+	AC_INT_VEC_REL_OP(!=)
+	AC_INT_VEC_REL_OP(<)
+	AC_INT_VEC_REL_OP(<=)
+	AC_INT_VEC_REL_OP(>)
+	AC_INT_VEC_REL_OP(>=)
+#undef AC_INT_VEC_REL_OP
+
+	sum_type reduce_add() const {
+		return reduce_add(std::integral_constant<bool, std::is_integral<lane_t>::value && sum_type::width <= 64>());
+	}
+
+#define AC_INT_VEC_REDUCE(NAME, EXPR) \
+	ac_int<W, S> NAME() const { \
+		lane_t t[N]; \
+		AC_INT_VEC_LANES \
+		for (int i = 0; i < N; i++) { \
+			t[i] = v[i]; \
+		} \
+		_Pragma("unroll") \
+		for (int s = 1; s < N; s *= 2) { \
+			_Pragma("unroll") \
+			for (int i = 0; i + s < N; i += 2 * s) { \
+				const lane_t a = t[i], b = t[i + s]; \
+				t[i] = EXPR; \
+			} \
+		} \
+		return lane::to_ac(t[0]); \
+	}
+
+	AC_INT_VEC_REDUCE(reduce_min, b < a ? b : a)
+	AC_INT_VEC_REDUCE(reduce_max, a < b ? b : a)
+	AC_INT_VEC_REDUCE(reduce_and, (lane_t) (a & b))
+	AC_INT_VEC_REDUCE(reduce_or, (lane_t) (a | b))
+	AC_INT_VEC_REDUCE(reduce_xor, (lane_t) (a ^ b))
+#undef AC_INT_VEC_REDUCE
+
+private:
+	// built-in lanes, the sum fits a 64 bit accumulator
+	sum_type reduce_add(std::true_type) const {
+		typedef typename std::conditional<S, Slong, Ulong>::type acc_t;
+		acc_t s = 0;
+		AC_INT_VEC_LANES
+		for (int i = 0; i < N; i++) {
+			s += (acc_t) v[i];
+		}
+		return sum_type(s);
+	}
+	sum_type reduce_add(std::false_type) const {
+		sum_type t[N];
+#pragma unroll
+		for (int i = 0; i < N; i++) {
+			t[i] = lane::to_ac(v[i]);
+		}
+		// adder tree
+#pragma unroll
+		for (int s = 1; s < N; s *= 2) {
+#pragma unroll
+			for (int i = 0; i + s < N; i += 2 * s) {
+				t[i] += t[i + s];
+			}
+		}
+		return t[0];
+	}
+};
+
+template<int W, bool S, int N>
+ac_int_vec<W, S, N> select(const ac_int_vec<1, false, N> &m, const ac_int_vec<W, S, N> &a, const ac_int_vec<W, S, N> &b) {
+	ac_int_vec<W, S, N> r;
+	AC_INT_VEC_LANES
+	for (int i = 0; i < N; i++) {
+		r.v[i] = m.v[i] ? a.v[i] : b.v[i];
+	}
+	return r;
+}
+
+#endif //__HLS_AC_INT_VEC_H__
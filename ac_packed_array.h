@@ -0,0 +1,204 @@
+#ifndef __HLS_AC_PACKED_ARRAY_H__
+#define __HLS_AC_PACKED_ARRAY_H__
+
+#include "HLS/hls.h"
+#include "HLS/ac_int.h"
+
+// This is template library for arrays of ac_int stored at exactly W bits per element.
+// ac_int<W,S> x[N] takes at least one machine word per element in emulation, whatever W is, so
+// ac_packed_array<3,false,1<<24> takes 6 MB where ac_int<3,false>[1<<24] takes 128 MB.
+//
+// template arguments
+//			- W, S                    - Width and signedness of the elements, as for ac_int<W,S>
+//			- N                       - Number of elements
+//
+// operations
+//			- a[i]                    - Reference to element i, converts to ac_int<W,S> and can be assigned
+//			                            an ac_int<W,S> (or anything that converts to it) or combined with +=, -=, &=, |=, ^=
+//			- a.get(i), a.set(i, x)   - Read and write element i
+//			- a.get(i, dst, n)        - Read elements i .. i+n-1 to dst[0 .. n-1]
+//			- a.set(i, src, n)        - Write src[0 .. n-1] to elements i .. i+n-1
+//			- a.fill(x)               - Set every element to x
+//
+// example - bloom filter of 2^20 bits:
+//			static ac_packed_array<1,false,1<<20> bloom;
+//			bloom[h1] = 1;
+//			bool maybe = ac_int<1,false>(bloom[h1]) == 1;
+//
+// In synthesis the array is a plain ac_int<W,S>[N], which the compiler builds as an on-chip memory of
+// W bit words, and a[i] is a reference to the element itself. Use ac_int<W,S>(a[i]) or a.get(i) where
+// the element is read, so the same code compiles in both.
+//
+// x86 emulation
+//			When HLS_X86 is defined the elements are packed into 64 bit words, element i at bits i*W .. i*W+W-1
+//			of the bit string. a[i] is a proxy. The bulk get and set stream through the words and, when W divides
+//			64 and the run starts on a word boundary, unpack and pack one whole word at a time.
+
+namespace ac_packed_internal {
+	// n <= 64 bits at bit position p of w, w has one spare word at the end
+	inline Ulong get_bits(const Ulong *w, Ulong p, int n) {
+		const Ulong i = p >> 6;
+		const int o = p & 63;
+		Ulong x = w[i] >> o;
+		if (o + n > 64) {
+			x |= w[i + 1] << (64 - o);
+		}
+		return n == 64 ? x : x & (((Ulong) 1 << n) - 1);
+	}
+
+	inline void set_bits(Ulong *w, Ulong p, int n, Ulong x) {
+		const Ulong i = p >> 6;
+		const int o = p & 63;
+		const Ulong m = n == 64 ? ~(Ulong) 0 : ((Ulong) 1 << n) - 1;
+		x &= m;
+		w[i] = (w[i] & ~(m << o)) | (x << o);
+		if (o + n > 64) {
+			w[i + 1] = (w[i + 1] & ~(m >> (64 - o))) | (x >> (64 - o));
+		}
+	}
+
+	// Conversion of the W bit pattern of an element from and to ac_int<W,S>
+	template<int W, bool S, bool WIDE = (W > 64)>
+	struct elem {
+		static ac_int<W, S> get(const Ulong *w, Ulong p) {
+			const Ulong x = get_bits(w, p, W);
+			return S && W < 64 ? ac_int<W, S>((Slong) (x << (64 - W) % 64) >> (64 - W) % 64) : ac_int<W, S>(x);
+		}
+		static void set(Ulong *w, Ulong p, const ac_int<W, S> &x) { set_bits(w, p, W, x.to_uint64()); }
+	};
+
+	template<int W, bool S>
+	struct elem<W, S, true> {
+		enum { C = (W + 63) / 64 };
+		static ac_int<W, S> get(const Ulong *w, Ulong p) {
+			ac_int<W, false> u = 0;
+			for (int c = C - 1; c >= 0; c--) {
+				const int n = c == C - 1 ? W - 64 * c : 64;
+				u = (u << 64) | ac_int<W, false>(get_bits(w, p + 64 * c, n));
+			}
+			return u;
+		}
+		static void set(Ulong *w, Ulong p, const ac_int<W, S> &x) {
+			ac_int<W, false> u = x;
+			for (int c = 0; c < C; c++) {
+				const int n = c == C - 1 ? W - 64 * c : 64;
+				set_bits(w, p + 64 * c, n, u.to_uint64());
+				u >>= 64;
+			}
+		}
+	};
+}
+
+template<int W, bool S, int N>
+class ac_packed_array {
+#ifdef HLS_X86
+	typedef ac_packed_internal::elem<W, S> elem;
+	enum { WORDS = (int) (((Ulong) W * N + 63) / 64) + 1 };
+	Ulong w[WORDS];
+
+public:
+	class reference {
+		ac_packed_array &a;
+		int i;
+	public:
+		reference(ac_packed_array &arr, int index) : a(arr), i(index) {}
+		operator ac_int<W, S> () const { return a.get(i); }
+		reference &operator=(const ac_int<W, S> &x) {
+			a.set(i, x);
+			return *this;
+		}
+		reference &operator=(const reference &o) { return *this = (ac_int<W, S>) o; }
+		reference &operator+=(const ac_int<W, S> &x) { return *this = ac_int<W, S>(a.get(i) + x); }
+		reference &operator-=(const ac_int<W, S> &x) { return *this = ac_int<W, S>(a.get(i) - x); }
+		reference &operator&=(const ac_int<W, S> &x) { return *this = ac_int<W, S>(a.get(i) & x); }
+		reference &operator|=(const ac_int<W, S> &x) { return *this = ac_int<W, S>(a.get(i) | x); }
+		reference &operator^=(const ac_int<W, S> &x) { return *this = ac_int<W, S>(a.get(i) ^ x); }
+	};
+
+	ac_packed_array() {
+		for (int k = 0; k < WORDS; k++) {
+			w[k] = 0;
+		}
+	}
+
+	reference operator[](int i) { return reference(*this, i); }
+	ac_int<W, S> operator[](int i) const { return get(i); }
+	ac_int<W, S> get(int i) const { return elem::get(w, (Ulong) i * W); }
+	void set(int i, const ac_int<W, S> &x) { elem::set(w, (Ulong) i * W, x); }
+
+	void get(int i, ac_int<W, S> *dst, int n) const {
+		AC_ASSERT(i >= 0 && n >= 0 && i + n <= N, "ac_packed_array run out of bounds");
+		Ulong p = (Ulong) i * W;
+		int k = 0;
+		if (W < 64 && 64 % W == 0 && (p & 63) == 0) {
+			const int PER = W < 64 && 64 % W == 0 ? 64 / W : 1;
+			const Ulong m = ((Ulong) 1 << W % 64) - 1;
+			for (Ulong j = p >> 6; k + PER <= n; j++) {
+				Ulong x = w[j];
+				for (int e = 0; e < PER; e++, k++) {
+					dst[k] = S ? ac_int<W, S>((Slong) (x << (64 - W) % 64) >> (64 - W) % 64) : ac_int<W, S>(x & m);
+					x >>= W % 64;
+				}
+			}
+			p += (Ulong) k * W;
+		}
+		for (; k < n; k++, p += W) {
+			dst[k] = elem::get(w, p);
+		}
+	}
+
+	void set(int i, const ac_int<W, S> *src, int n) {
+		AC_ASSERT(i >= 0 && n >= 0 && i + n <= N, "ac_packed_array run out of bounds");
+		Ulong p = (Ulong) i * W;
+		int k = 0;
+		if (W < 64 && 64 % W == 0 && (p & 63) == 0) {
+			const int PER = W < 64 && 64 % W == 0 ? 64 / W : 1;
+			const Ulong m = ((Ulong) 1 << W % 64) - 1;
+			for (Ulong j = p >> 6; k + PER <= n; j++) {
+				Ulong x = 0;
+				for (int e = 0; e < PER; e++, k++) {
+					x |= (src[k].to_uint64() & m) << (e * W) % 64;
+				}
+				w[j] = x;
+			}
+			p += (Ulong) k * W;
+		}
+		for (; k < n; k++, p += W) {
+			elem::set(w, p, src[k]);
+		}
+	}
+#else
+	ac_int<W, S> m[N];
+
+public:
+	typedef ac_int<W, S> &reference;
+
+	ac_packed_array() {}
+
+	reference operator[](int i) { return m[i]; }
+	ac_int<W, S> operator[](int i) const { return m[i]; }
+	ac_int<W, S> get(int i) const { return m[i]; }
+	void set(int i, const ac_int<W, S> &x) { m[i] = x; }
+
+	void get(int i, ac_int<W, S> *dst, int n) const {
+		for (int k = 0; k < n; k++) {
+			dst[k] = m[i + k];
+		}
+	}
+	void set(int i, const ac_int<W, S> *src, int n) {
+		for (int k = 0; k < n; k++) {
+			m[i + k] = src[k];
+		}
+	}
+#endif
+
+	void fill(const ac_int<W, S> &x) {
+		for (int i = 0; i < N; i++) {
+			set(i, x);
+		}
+	}
+	static const int size = N;
+	static const int width = W;
+};
+
+#endif //__HLS_AC_PACKED_ARRAY_H__
@@ -0,0 +1,385 @@
+#ifndef __HLS_AC_SERIALIZE_H__
+#define __HLS_AC_SERIALIZE_H__
+
+#include "HLS/hls.h"
+#include "HLS/ac_fixed.h"
+#include "HLS/ac_packed_array.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define AC_SERIALIZE_MMAP
+// the pages of a file being read are mapped in one go instead of on every first access
+#ifdef MAP_POPULATE
+#define AC_SERIALIZE_POPULATE MAP_POPULATE
+#else
+#define AC_SERIALIZE_POPULATE 0
+#endif
+#endif
+// little endian hosts use the payload words as they are, others convert them in place after packing and before unpacking
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define AC_SERIALIZE_LITTLE_ENDIAN
+#endif
+
+// This is template library for saving and loading arrays of ac_int and ac_fixed in a compact binary file,
+// for exchanging golden vectors between testbenches.
+//
+// file format, version 1, little endian
+//			- header                  - 64 bytes: "ACBINARY", version, header size, W, I, S, Q, O of the
+//			                            element type and the number of elements
+//			- payload                 - The elements bit-packed at exactly W bits each, element i at bits
+//			                            i*W .. i*W+W-1, in 64 bit words. The same layout as ac_packed_array.
+// Files are little endian on every host, so they can be exchanged between hosts.
+// ac_int<W,S> is recorded as W, I = W, S, AC_TRN, AC_WRAP.
+//
+// functions
+//			- ac::save(path, data, n)         - Writes data[0 .. n-1], returns false if the file cannot be written
+//			- ac::load(path, data, max_n)     - Reads up to max_n elements, returns their number, or -1 if the file
+//			                                    cannot be read, is not in this format or holds another type
+//			- ac_mapped_array<T>              - Read-only view of a file: open(path), size(), a[i], get(i, dst, n)
+//
+// example:
+//			ac_fixed<20,4,true> golden[1024];
+//			ac::save("golden.acb", golden, 1024);
+//			ac_mapped_array< ac_fixed<20,4,true> > m;
+//			if (m.open("golden.acb")) { ac_fixed<20,4,true> x = m[7]; }
+//
+// On Linux and macOS the file is memory mapped, the writer packs the elements straight into the mapping
+// and the readers unpack them straight out of it, no buffer is copied. On other systems the payload is
+// read and written with stdio through one buffer.
+
+namespace ac_serialize_internal {
+	enum { VERSION = 1, HEADER_BYTES = 64 };
+
+	struct header {
+		char magic[8];
+		uint32_t version;
+		uint32_t header_bytes;
+		int32_t width;
+		int32_t i_width;
+		uint32_t sign;
+		uint32_t q_mode;
+		uint32_t o_mode;
+		uint32_t reserved;
+		uint64_t count;
+		uint64_t payload_bytes;
+		uint8_t pad[8];
+	};
+
+	template<typename T>
+	inline header make_header(uint64_t n) {
+		header h;
+		memset(&h, 0, sizeof(h));
+		memcpy(h.magic, "ACBINARY", 8);
+		h.version = VERSION;
+		h.header_bytes = HEADER_BYTES;
+		h.width = T::width;
+		h.i_width = T::i_width;
+		h.sign = T::sign;
+		h.q_mode = T::q_mode;
+		h.o_mode = T::o_mode;
+		h.count = n;
+		h.payload_bytes = ((uint64_t) T::width * n + 63) / 64 * 8;
+		return h;
+	}
+
+	inline void put_le(unsigned char *p, uint64_t x, int bytes) {
+		for (int i = 0; i < bytes; i++) {
+			p[i] = (unsigned char) (x >> (8 * i));
+		}
+	}
+	inline uint64_t get_le(const unsigned char *p, int bytes) {
+		uint64_t x = 0;
+		for (int i = 0; i < bytes; i++) {
+			x |= (uint64_t) p[i] << (8 * i);
+		}
+		return x;
+	}
+
+	// the header fields are stored little endian at their offsets in struct header
+	inline void write_header(unsigned char *p, const header &h) {
+		memset(p, 0, HEADER_BYTES);
+		memcpy(p, h.magic, 8);
+		put_le(p + 8, h.version, 4);
+		put_le(p + 12, h.header_bytes, 4);
+		put_le(p + 16, (uint32_t) h.width, 4);
+		put_le(p + 20, (uint32_t) h.i_width, 4);
+		put_le(p + 24, h.sign, 4);
+		put_le(p + 28, h.q_mode, 4);
+		put_le(p + 32, h.o_mode, 4);
+		put_le(p + 36, h.reserved, 4);
+		put_le(p + 40, h.count, 8);
+		put_le(p + 48, h.payload_bytes, 8);
+	}
+	inline header read_header(const unsigned char *p) {
+		header h;
+		memset(&h, 0, sizeof(h));
+		memcpy(h.magic, p, 8);
+		h.version = (uint32_t) get_le(p + 8, 4);
+		h.header_bytes = (uint32_t) get_le(p + 12, 4);
+		h.width = (int32_t) (uint32_t) get_le(p + 16, 4);
+		h.i_width = (int32_t) (uint32_t) get_le(p + 20, 4);
+		h.sign = (uint32_t) get_le(p + 24, 4);
+		h.q_mode = (uint32_t) get_le(p + 28, 4);
+		h.o_mode = (uint32_t) get_le(p + 32, 4);
+		h.reserved = (uint32_t) get_le(p + 36, 4);
+		h.count = get_le(p + 40, 8);
+		h.payload_bytes = get_le(p + 48, 8);
+		return h;
+	}
+
+	// converts n payload words between the host order and little endian in place
+	inline void payload_order(Ulong *w, uint64_t n, bool to_le) {
+#ifndef AC_SERIALIZE_LITTLE_ENDIAN
+		for (uint64_t i = 0; i < n; i++) {
+			unsigned char *b = (unsigned char *) (w + i);
+			if (to_le) {
+				put_le(b, w[i], 8);
+			} else {
+				w[i] = get_le(b, 8);
+			}
+		}
+#else
+		(void) w;
+		(void) n;
+		(void) to_le;
+#endif
+	}
+
+	// Whole file mapped for reading, or for writing a new file of a given size. A file mapped for reading is
+	// private, so its payload can be converted to the host order without changing the file.
+	class mapping {
+	public:
+		unsigned char *data;
+		size_t size;
+		mapping() : data(0), size(0), writable(false), fd(-1) {}
+		~mapping() { close(); }
+
+		bool open_read(const char *path) {
+			close();
+#ifdef AC_SERIALIZE_MMAP
+			fd = ::open(path, O_RDONLY);
+			struct stat st;
+			if (fd < 0 || fstat(fd, &st) != 0 || st.st_size < HEADER_BYTES) {
+				close();
+				return false;
+			}
+			size = st.st_size;
+#ifdef AC_SERIALIZE_LITTLE_ENDIAN
+			const int prot = PROT_READ;
+#else
+			const int prot = PROT_READ | PROT_WRITE;
+#endif
+			void *p = mmap(0, size, prot, MAP_PRIVATE | AC_SERIALIZE_POPULATE, fd, 0);
+			if (p == MAP_FAILED) {
+				close();
+				return false;
+			}
+			data = (unsigned char *) p;
+			madvise(p, size, MADV_SEQUENTIAL);
+			return true;
+#else
+			FILE *f = fopen(path, "rb");
+			if (!f) {
+				return false;
+			}
+			fseek(f, 0, SEEK_END);
+			const long n = ftell(f);
+			fseek(f, 0, SEEK_SET);
+			data = n >= HEADER_BYTES ? (unsigned char *) malloc(n) : 0;
+			size = n;
+			const bool ok = data && fread(data, 1, size, f) == size;
+			fclose(f);
+			if (!ok) {
+				close();
+			}
+			return ok;
+#endif
+		}
+
+		// the new file is zero filled
+		bool create(const char *path, size_t bytes) {
+			close();
+			writable = true;
+			size = bytes;
+#ifdef AC_SERIALIZE_MMAP
+			fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if (fd < 0 || ftruncate(fd, size) != 0) {
+				close();
+				return false;
+			}
+			void *p = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (p == MAP_FAILED) {
+				close();
+				return false;
+			}
+			data = (unsigned char *) p;
+			return true;
+#else
+			path_copy = path;
+			data = (unsigned char *) calloc(size, 1);
+			return data != 0;
+#endif
+		}
+
+		// writes a created file out, returns false on failure
+		bool close() {
+			bool ok = true;
+#ifdef AC_SERIALIZE_MMAP
+			if (data) {
+				if (writable) {
+					ok = msync(data, size, MS_SYNC) == 0;
+				}
+				munmap(data, size);
+			}
+			if (fd >= 0) {
+				ok = ::close(fd) == 0 && ok;
+			}
+			fd = -1;
+#else
+			if (data && writable) {
+				FILE *f = fopen(path_copy.c_str(), "wb");
+				ok = f && fwrite(data, 1, size, f) == size;
+				ok = f && fclose(f) == 0 && ok;
+			}
+			free(data);
+#endif
+			data = 0;
+			size = 0;
+			writable = false;
+			return ok;
+		}
+
+	private:
+		bool writable;
+		int fd;
+#ifndef AC_SERIALIZE_MMAP
+		std::string path_copy;
+#endif
+		mapping(const mapping &);
+		mapping &operator=(const mapping &);
+	};
+
+	// checks the header against T, returns the payload in the host order
+	template<typename T>
+	inline const Ulong *payload(mapping &m, uint64_t &n) {
+		const header h = read_header(m.data);
+		// a count the file cannot hold would wrap T::width * count
+		if (h.header_bytes > m.size || h.count > (uint64_t) (m.size - h.header_bytes) * 8 / T::width) {
+			return 0;
+		}
+		const header e = make_header<T>(h.count);
+		if (memcmp(h.magic, e.magic, 8) != 0 || h.version != VERSION || h.header_bytes < HEADER_BYTES || h.header_bytes % 8 != 0 ||
+		    h.width != e.width || h.i_width != e.i_width || h.sign != e.sign || h.q_mode != e.q_mode || h.o_mode != e.o_mode ||
+		    h.payload_bytes != e.payload_bytes || m.size < h.header_bytes + h.payload_bytes) {
+			return 0;
+		}
+		n = h.count;
+		Ulong *w = (Ulong *) (m.data + h.header_bytes);
+		payload_order(w, h.payload_bytes / 8, false);
+		return w;
+	}
+
+	// the W bits of an element, ac_int is assigned directly as set_slc is much slower
+	template<int W, bool S>
+	inline const ac_int<W, S> &bits(const ac_int<W, S> &x) { return x; }
+	template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+	inline ac_int<W, S> bits(const ac_fixed<W, I, S, Q, O> &x) { return x.template slc<W>(0); }
+	template<int W, bool S>
+	inline void set_bits(ac_int<W, S> &x, const ac_int<W, S> &b) { x = b; }
+	template<int W, int I, bool S, ac_q_mode Q, ac_o_mode O>
+	inline void set_bits(ac_fixed<W, I, S, Q, O> &x, const ac_int<W, S> &b) { x.set_slc(0, b); }
+
+	template<typename T>
+	inline void unpack(const Ulong *w, uint64_t first, T *dst, uint64_t n) {
+		typedef ac_packed_internal::elem<T::width, T::sign> elem;
+		Ulong p = first * T::width;
+		for (uint64_t i = 0; i < n; i++, p += T::width) {
+			set_bits(dst[i], elem::get(w, p));
+		}
+	}
+}
+
+template<typename T>
+class ac_mapped_array {
+	ac_serialize_internal::mapping m;
+	const Ulong *w;
+	uint64_t n;
+
+public:
+	ac_mapped_array() : w(0), n(0) {}
+
+	// false if the file cannot be read, is not in the format of HLS/ac_serialize.h or holds another type than T
+	bool open(const char *path) {
+		w = 0;
+		n = 0;
+		if (!m.open_read(path)) {
+			return false;
+		}
+		w = ac_serialize_internal::payload<T>(m, n);
+		if (!w) {
+			m.close();
+		}
+		return w != 0;
+	}
+	void close() {
+		m.close();
+		w = 0;
+		n = 0;
+	}
+	long long size() const { return (long long) n; }
+
+	T operator[](long long i) const {
+		AC_ASSERT(i >= 0 && (uint64_t) i < n, "ac_mapped_array index out of bounds");
+		T x;
+		ac_serialize_internal::unpack<T>(w, i, &x, 1);
+		return x;
+	}
+	// dst[0 .. count-1] = elements i .. i+count-1
+	void get(long long i, T *dst, long long count) const {
+		AC_ASSERT(i >= 0 && count >= 0 && (uint64_t) (i + count) <= n, "ac_mapped_array run out of bounds");
+		ac_serialize_internal::unpack<T>(w, i, dst, count);
+	}
+};
+
+namespace ac {
+	template<typename T>
+	inline bool save(const char *path, const T *data, long long n) {
+		typedef ac_packed_internal::elem<T::width, T::sign> elem;
+		const ac_serialize_internal::header h = ac_serialize_internal::make_header<T>(n);
+		ac_serialize_internal::mapping m;
+		if (n < 0 || !m.create(path, ac_serialize_internal::HEADER_BYTES + h.payload_bytes)) {
+			return false;
+		}
+		ac_serialize_internal::write_header(m.data, h);
+		Ulong *w = (Ulong *) (m.data + ac_serialize_internal::HEADER_BYTES);
+		Ulong p = 0;
+		for (long long i = 0; i < n; i++, p += T::width) {
+			elem::set(w, p, ac_serialize_internal::bits(data[i]));
+		}
+		ac_serialize_internal::payload_order(w, h.payload_bytes / 8, true);
+		return m.close();
+	}
+
+	template<typename T>
+	inline long long load(const char *path, T *data, long long max_n) {
+		ac_serialize_internal::mapping m;
+		uint64_t n = 0;
+		const Ulong *w = m.open_read(path) ? ac_serialize_internal::payload<T>(m, n) : 0;
+		if (!w) {
+			return -1;
+		}
+		if (n > (uint64_t) max_n) {
+			n = max_n;
+		}
+		ac_serialize_internal::unpack<T>(w, 0, data, n);
+		return (long long) n;
+	}
+}
+
+#endif //__HLS_AC_SERIALIZE_H__
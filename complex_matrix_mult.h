@@ -0,0 +1,120 @@
+#ifndef __HLS_COMPLEX_MATRIX_MULT_H__
+#define __HLS_COMPLEX_MATRIX_MULT_H__
+
+#include "HLS/hls.h"
+#include "HLS/matrix_mult.h"
+
+// This is template library for complex matrix multiplication on the dot-product datapath of HLS/matrix_mult.h.
+// A x B = C with elements hls_complex<T>, T e.g. float or ac_fixed. Every complex product
+//			(a + bi)(c + di) = (k1 - k3) + (k1 + k2)i,  k1 = c(a + b), k2 = a(d - c), k3 = b(c + d)
+// takes 3 real multipliers instead of 4 (Gauss). The sum a + b is formed once when an element of A
+// is loaded and kept in the A registers next to it, c + d and d - c are formed when B is read, so
+// a complex MAC costs 3 multipliers and 5 adders.
+//
+// template arguments
+//			- T                       - Data type of the real and imaginary parts
+//			- t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L
+//			                          - As for matrix_multiply, 3 * DOT_VEC_SIZE real multipliers are used
+//
+// function arguments
+//			- A[][] -  A input 2 dimensional matrix of hls_complex<T>
+//			- B[][] -  B input 2 dimensional matrix of hls_complex<T>
+//			- C[][] -  C output 2 dimensional matrix of hls_complex<T>
+//
+// The products are formed in the full precision of T op T (exact for ac_fixed) and added in T.
+// The x86 path runs the cache-blocked kernel on the same products, so it matches the schedule exactly.
+
+template<class T>
+struct hls_complex {
+	T r, i;
+
+	hls_complex() {}
+	hls_complex(const T &re, const T &im = T(0)) : r(re), i(im) {}
+	template<class U>
+	explicit hls_complex(const hls_complex<U> &o) : r(o.r), i(o.i) {}
+
+	template<class U>
+	hls_complex &operator+=(const hls_complex<U> &o) {
+		r += o.r;
+		i += o.i;
+		return *this;
+	}
+	hls_complex operator+(const hls_complex &o) const { return hls_complex(r + o.r, i + o.i); }
+	hls_complex operator-(const hls_complex &o) const { return hls_complex(r - o.r, i - o.i); }
+	// plain 4 multiplier product
+	hls_complex operator*(const hls_complex &o) const { return hls_complex(r * o.r - i * o.i, r * o.i + i * o.r); }
+	bool operator==(const hls_complex &o) const { return r == o.r && i == o.i; }
+	bool operator!=(const hls_complex &o) const { return !(*this == o); }
+};
+
+namespace complex_mult_internal {
+	// Element of A as held in the A registers, with its precomputed sum a + b
+	template<class T>
+	struct gauss_a {
+		typedef decltype(T() + T()) sum_t;
+		T r, i;
+		sum_t sum;
+		gauss_a() {}
+		explicit gauss_a(const hls_complex<T> &v) : r(v.r), i(v.i), sum(v.r + v.i) {}
+	};
+
+	// Element of B with d - c and c + d
+	template<class T>
+	struct gauss_b {
+		typedef decltype(T() + T()) sum_t;
+		T r;
+		sum_t i_minus_r, r_plus_i;
+		gauss_b() {}
+		explicit gauss_b(const hls_complex<T> &v) : r(v.r), i_minus_r(v.i - v.r), r_plus_i(v.r + v.i) {}
+	};
+
+	template<class T>
+	auto operator*(const gauss_a<T> &a, const gauss_b<T> &b) -> hls_complex<decltype(b.r * a.sum - a.i * b.r_plus_i)> {
+		typedef decltype(b.r * a.sum - a.i * b.r_plus_i) result_t;
+		const auto k1 = b.r * a.sum;
+		const auto k2 = a.r * b.i_minus_r;
+		const auto k3 = a.i * b.r_plus_i;
+		return hls_complex<result_t>(k1 - k3, k1 + k2);
+	}
+
+	template<class T, int COLS>
+	struct a_source {
+		hls_complex<T> (*m)[COLS];
+		gauss_a<T> operator()(int row, int col) const { return gauss_a<T>(m[row][col]); }
+	};
+
+	template<class T, int COLS>
+	struct b_source {
+		hls_complex<T> (*m)[COLS];
+		gauss_b<T> operator()(int row, int col) const { return gauss_b<T>(m[row][col]); }
+	};
+}
+
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+void matrix_multiply_complex(hls_complex<T> A_local[t_rowsA][t_colsA], hls_complex<T> B_local[t_colsA][t_colsB], hls_complex<T> C_local[t_rowsA][t_colsB]) {
+	matrix_mult_internal::check_params<t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>();
+	matrix_mult_internal::array_sink<hls_complex<T>, t_colsB> c = {C_local};
+#if defined(HLS_X86) && !defined(MATRIX_MULT_EMULATE_SCHEDULE)
+	static complex_mult_internal::gauss_a<T> A_gauss[t_rowsA][t_colsA];
+	static complex_mult_internal::gauss_b<T> B_gauss[t_colsA][t_colsB];
+	for (int i = 0; i < t_rowsA; ++i) {
+		for (int k = 0; k < t_colsA; ++k) {
+			A_gauss[i][k] = complex_mult_internal::gauss_a<T>(A_local[i][k]);
+		}
+	}
+	for (int k = 0; k < t_colsA; ++k) {
+		for (int j = 0; j < t_colsB; ++j) {
+			B_gauss[k][j] = complex_mult_internal::gauss_b<T>(B_local[k][j]);
+		}
+	}
+	matrix_multiply_x86_kernel<complex_mult_internal::gauss_a<T>, complex_mult_internal::gauss_b<T>, hls_complex<T>,
+	                           t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_gauss, B_gauss, c);
+#else
+	complex_mult_internal::a_source<T, t_colsA> a = {A_local};
+	complex_mult_internal::b_source<T, t_colsB> b = {B_local};
+	matrix_mult_internal::dot_product_engine<complex_mult_internal::gauss_a<T>, hls_complex<T>,
+	                                         t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c);
+#endif
+}
+
+#endif //__HLS_COMPLEX_MATRIX_MULT_H__
@@ -0,0 +1,107 @@
+#ifndef __HLS_CONV2D_H__
+#define __HLS_CONV2D_H__
+
+#include "HLS/hls.h"
+#include "HLS/matrix_mult.h"
+
+// This is template library for streaming 2D convolution on the dot-product datapath of HLS/matrix_mult.h.
+// Every output pixel is the product of its KH x KW x CIN input window with a KH*KW*CIN x COUT weight
+// matrix, i.e. one row of an im2col matrix multiply. The windows are never materialized: the last rows
+// of the image are kept in on-chip line buffers and the schedule reads the window elements directly
+// from them, while the next input row is loaded from the stream in the same loop iterations.
+//
+// template arguments
+//			- T                       - Data type of pixels and weights
+//			- H, W                    - Height and width of the input image
+//			- CIN                     - Number of input channels
+//			- COUT                    - Number of output channels
+//			- KH, KW                  - Height and width of the kernel
+//			- DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L
+//			                          - As for matrix_multiply with t_colsA = KH*KW*CIN and t_colsB = COUT
+//
+// function arguments
+//			- in        - stream_in of H*W*CIN values, row by row, pixel by pixel, channels innermost
+//			- weights[] - weights[(ky * KW + kx) * CIN + c][cout]
+//			- out       - stream_out of (H-KH+1)*(W-KW+1)*COUT values, in the same order as the input
+//
+// The convolution has stride 1 and no padding. Output row oy is computed while input row oy + KH is
+// read, so the loads are hidden as long as W*CIN <= matrix_multiply_cycles<W-KW+1, KH*KW*CIN, COUT, DOT_VEC_SIZE>().
+
+namespace conv2d_internal {
+	// Window elements of output row oy, read from the line buffers
+	template<class T, int W, int CIN, int KW, int SLOTS>
+	struct window_source {
+		T (*lines)[W][CIN];
+		int oy;
+		T operator()(int ox, int k) const {
+			const int ky = k / (KW * CIN);
+			const int kx = (k / CIN) % KW;
+			const int c = k % CIN;
+			return lines[(oy + ky) % SLOTS][ox + kx][c];
+		}
+	};
+
+	// Side task reading the next input row into its line buffer, one value per call
+	template<class T, int W, int CIN, class... Params>
+	struct line_loader {
+		ihc::stream_in<T, Params...> &in;
+		T (*line)[CIN];
+		bool load;
+		void operator()(int k) const {
+			if (load && k < W * CIN) {
+				line[k / CIN][k % CIN] = in.read();
+			}
+		}
+	};
+}
+
+template<class T, int H, int W, int CIN, int COUT, int KH, int KW,
+         int DOT_VEC_SIZE = KH * KW * CIN, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1,
+         class... InParams, class... OutParams>
+void conv2d(ihc::stream_in<T, InParams...> &in, T weights[KH * KW * CIN][COUT], ihc::stream_out<T, OutParams...> &out) {
+	const int OH = H - KH + 1;
+	const int OW = W - KW + 1;
+	const int K = KH * KW * CIN;
+	// KH rows of the current windows plus the row being loaded
+	const int SLOTS = KH + 1;
+	static_assert(OH > 0 && OW > 0, "the kernel does not fit into the image");
+	matrix_mult_internal::check_params<K, COUT, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>();
+
+	T line_buf[SLOTS][W][CIN];
+	for (int y = 0; y < KH; ++y) {
+		for (int x = 0; x < W; ++x) {
+			for (int c = 0; c < CIN; ++c) {
+				line_buf[y][x][c] = in.read();
+			}
+		}
+	}
+
+	matrix_mult_internal::stream_sink<T, OutParams...> c = {out};
+	for (int oy = 0; oy < OH; ++oy) {
+		conv2d_internal::line_loader<T, W, CIN, InParams...> loader = {in, line_buf[(oy + KH) % SLOTS], oy + KH < H};
+#if defined(HLS_X86) && !defined(MATRIX_MULT_EMULATE_SCHEDULE)
+		// gather the windows of the row for the x86 kernel
+		static T windows[OW][K];
+		conv2d_internal::window_source<T, W, CIN, KW, SLOTS> window = {line_buf, oy};
+		for (int ox = 0; ox < OW; ++ox) {
+			for (int k = 0; k < K; ++k) {
+				windows[ox][k] = window(ox, k);
+			}
+		}
+		for (int k = 0; k < W * CIN; ++k) {
+			loader(k);
+		}
+		matrix_multiply_x86_kernel<T, T, T, OW, K, COUT, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(windows, weights, c);
+#else
+		conv2d_internal::window_source<T, W, CIN, KW, SLOTS> a = {line_buf, oy};
+		matrix_mult_internal::array_source<T, COUT> b = {weights};
+		matrix_mult_internal::dot_product_engine<T, T, OW, K, COUT, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c, loader);
+		// loads that did not fit into the schedule
+		for (int k = matrix_multiply_cycles<OW, K, COUT, DOT_VEC_SIZE>(); k < W * CIN; ++k) {
+			loader(k);
+		}
+#endif
+	}
+}
+
+#endif //__HLS_CONV2D_H__
@@ -0,0 +1,191 @@
+#ifndef __HLS_BENCH_H__
+#define __HLS_BENCH_H__
+
+///////////////////////////////////////////////////////////////////////////////
+// Component Benchmark Harness
+//
+// Drives a component through ihc_hls_enqueue / ihc_hls_component_run_all and
+// reports comparable throughput and latency numbers for every design:
+//
+//   - x86 emulation:  invocations per second (wall clock)
+//   - cosimulation:   latency and initiation interval in clock cycles, derived
+//                     from ihc_hls_get_sim_time and the simulated clock period
+//
+// Inputs are either recorded (any container with size() and operator[] whose
+// elements are std::tuple of the component arguments) or generated (a callable
+// taking the invocation index and returning such a tuple). Generated inputs
+// are materialized before timing starts so they do not pollute the numbers.
+//
+//   component int dut(int a, int b);
+//
+//   std::vector<std::tuple<int,int>> recorded = load_vectors();
+//   ihc::bench::result r = ihc::bench::run_component(dut, recorded, 1000, "dut");
+//   ihc::bench::report(r);                      // one JSON object per line
+//
+//   auto gen = [](int i) { return std::make_tuple(i, 2 * i); };
+//   ihc::bench::report_csv(ihc::bench::run_component(dut, gen, 1000, "dut"));
+//
+// Every report line carries the same fields in the same order so results from
+// different designs can be concatenated and compared directly.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "HLS/hls.h"
+#include <chrono>
+#include <stdio.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ihc {
+namespace bench {
+
+struct result {
+  const char *name;
+  int invocations;
+  bool simulated;                      // a cosimulation target executed the component
+  double wall_seconds;                 // enqueue of all invocations up to completion
+  double invocations_per_second;
+  int clock_period_ps;                 // 0 when not simulated
+  unsigned long long latency_cycles;   // single invocation, 0 when not simulated
+  double ii_cycles;                    // average initiation interval, 0 when not simulated
+};
+
+namespace internal {
+
+  // C++14 replacement for std::index_sequence based std::apply
+  template<std::size_t... I> struct index_seq {};
+  template<std::size_t N, std::size_t... I>
+  struct make_index_seq : make_index_seq<N - 1, N - 1, I...> {};
+  template<std::size_t... I>
+  struct make_index_seq<0, I...> { typedef index_seq<I...> type; };
+
+  // A generator is anything callable with the invocation index
+  template<typename G, typename = void>
+  struct is_generator : std::false_type {};
+  template<typename G>
+  struct is_generator<G, decltype((void)std::declval<G&>()(0))> : std::true_type {};
+
+  template<typename R, typename... Args>
+  struct invoker {
+    std::vector<R> ret;
+    explicit invoker(int n) : ret(n > 0 ? n : 1) {}
+    template<typename Tuple, std::size_t... I>
+    void enqueue(int n, R (*fn)(Args...), Tuple &t, index_seq<I...>) {
+      ihc_hls_enqueue(&ret[n], fn, std::get<I>(t)...);
+    }
+  };
+
+  template<typename... Args>
+  struct invoker<void, Args...> {
+    explicit invoker(int) {}
+    template<typename Tuple, std::size_t... I>
+    void enqueue(int, void (*fn)(Args...), Tuple &t, index_seq<I...>) {
+      ihc_hls_enqueue_noret(fn, std::get<I>(t)...);
+    }
+  };
+
+  template<typename Inputs>
+  typename std::enable_if<!is_generator<Inputs>::value, Inputs&>::type
+  materialize(Inputs &inputs, int) {
+    return inputs;
+  }
+
+  template<typename Gen>
+  typename std::enable_if<is_generator<Gen>::value,
+                          std::vector<typename std::decay<decltype(std::declval<Gen&>()(0))>::type> >::type
+  materialize(Gen &gen, int N) {
+    std::vector<typename std::decay<decltype(gen(0))>::type> v;
+    v.reserve(N);
+    for (int i = 0; i < N; i++) {
+      v.push_back(gen(i));
+    }
+    return v;
+  }
+
+  template<typename R, typename... Args, typename Vectors>
+  double enqueue_and_run(R (*fn)(Args...), Vectors &vectors, int first, int N) {
+    typedef typename make_index_seq<sizeof...(Args)>::type seq;
+    invoker<R, Args...> inv(N);
+    int size = (int)vectors.size();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; i++) {
+      inv.enqueue(i, fn, vectors[(first + i) % size], seq());
+    }
+    ihc_hls_component_run_all(fn);
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+  }
+
+} // namespace internal
+
+// Runs fn N times on the supplied inputs. Recorded inputs are reused round
+// robin when N exceeds their count.
+template<typename R, typename... Args, typename Inputs>
+result run_component(R (*fn)(Args...), Inputs &&inputs, int N, const char *name = "component") {
+  result r;
+  r.name = name;
+  r.invocations = N;
+  r.simulated = __ihc_hls_async_call_capable() != 0;
+  r.wall_seconds = 0.0;
+  r.invocations_per_second = 0.0;
+  r.clock_period_ps = 0;
+  r.latency_cycles = 0;
+  r.ii_cycles = 0.0;
+
+  auto &&vectors = internal::materialize(inputs, N);
+  if (N <= 0 || vectors.size() == 0) {
+    return r;
+  }
+
+  unsigned long long latency_ps = 0;
+  if (r.simulated) {
+    // A lone invocation gives the latency, the pipelined batch below the II
+    unsigned long long t0 = ihc_hls_get_sim_time();
+    internal::enqueue_and_run(fn, vectors, 0, 1);
+    latency_ps = ihc_hls_get_sim_time() - t0;
+    r.clock_period_ps = __ihc_hls_get_clock_period_ps();
+  }
+
+  unsigned long long t0 = r.simulated ? ihc_hls_get_sim_time() : 0;
+  r.wall_seconds = internal::enqueue_and_run(fn, vectors, 0, N);
+  unsigned long long total_ps = r.simulated ? ihc_hls_get_sim_time() - t0 : 0;
+
+  if (r.wall_seconds > 0.0) {
+    r.invocations_per_second = N / r.wall_seconds;
+  }
+  if (r.simulated && r.clock_period_ps > 0) {
+    r.latency_cycles = latency_ps / r.clock_period_ps;
+    // total = latency + (N - 1) * II for a pipelined component
+    double total_cycles = (double)total_ps / r.clock_period_ps;
+    r.ii_cycles = N > 1 ? (total_cycles - r.latency_cycles) / (N - 1) : total_cycles;
+  }
+  return r;
+}
+
+// One JSON object per line
+inline void report(const result &r, FILE *f = stdout) {
+  fprintf(f, "{\"name\":\"%s\",\"invocations\":%d,\"simulated\":%s,"
+             "\"wall_seconds\":%.9g,\"invocations_per_second\":%.9g,"
+             "\"clock_period_ps\":%d,\"latency_cycles\":%llu,\"ii_cycles\":%.6g}\n",
+          r.name, r.invocations, r.simulated ? "true" : "false",
+          r.wall_seconds, r.invocations_per_second,
+          r.clock_period_ps, r.latency_cycles, r.ii_cycles);
+}
+
+inline void report_csv_header(FILE *f = stdout) {
+  fprintf(f, "name,invocations,simulated,wall_seconds,invocations_per_second,"
+             "clock_period_ps,latency_cycles,ii_cycles\n");
+}
+
+inline void report_csv(const result &r, FILE *f = stdout) {
+  fprintf(f, "%s,%d,%d,%.9g,%.9g,%d,%llu,%.6g\n",
+          r.name, r.invocations, r.simulated ? 1 : 0,
+          r.wall_seconds, r.invocations_per_second,
+          r.clock_period_ps, r.latency_cycles, r.ii_cycles);
+}
+
+} // namespace bench
+} // namespace ihc
+
+#endif //__HLS_BENCH_H__
@@ -1,3 +1,12 @@
+#ifndef __HLS_MATRIX_MULT_H__
+#define __HLS_MATRIX_MULT_H__
+
+#include "HLS/hls.h"
+
+#ifndef MATRIX_MULT_X86_PANEL_BYTES
+#define MATRIX_MULT_X86_PANEL_BYTES (256 * 1024)
+#endif
+
 // This is template library for matrix multiplication. A x B = C
 // template arguments
 //			- T                       - Data type of the matrix elements
@@ -20,110 +29,771 @@
 //			                            accumulation latency (latency to accumulate the partial products of elements of A row and B col).
 //			                            Try higher values for better Fmax. 
 //			                            The maximum value of RUNNING_SUM_MULT_L is num_iter_per_elem_L(=COLSA/DOT_VEC_SIZE). 
-//			                            If it goes higher than the max limit, then higher Fmax is achieved at the cost of more 
-//			                            clock cycles and resources which might result in increased overall latency.                                                                                       
+//			                            Higher values would mix the sums of consecutive rows of C and are rejected at compile time.
+//			Invalid combinations of these parameters are rejected with a static_assert. matmul_plan derives
+//			a valid combination from a DSP and memory bandwidth budget, see matrix_multiply_planned below.
 //					       
 // function arguments
 //			- A[][] -  A input 2 dimensional matrix
 //			- B[][] -  B input 2 dimensional matrix
 //			- C[][] -  C output 2 dimensional matrix
 //
+// x86 emulation
+//			When HLS_X86 is defined, matrix_multiply computes the product with a cache-blocked
+//			kernel whose inner loops run over contiguous rows of B and vectorize, instead of
+//			stepping through the cycle-accurate hardware schedule. The kernel keeps the
+//			accumulation order of the schedule (DOT_VEC_SIZE wide partial sums folded into
+//			RUNNING_SUM_MULT_L interleaved running sums), so floating-point results are identical
+//			as long as the compiler evaluates each operation as written. Build the testbench with
+//			-ffp-contract=off, otherwise GCC may fuse multiplies and adds into FMAs in one path and
+//			not the other (clang also accepts #pragma STDC FP_CONTRACT OFF), and without
+//			-ffast-math, which reorders the sums.
+//			- MATRIX_MULT_EMULATE_SCHEDULE - run the hardware schedule in emulation as well
+//			- MATRIX_MULT_VERIFY           - run both paths and stop with an error on any mismatch
+//			- MATRIX_MULT_X86_PANEL_BYTES  - size of the B column panel kept in cache (default 256KB)
+//
+// matrix_multiply_batched
+//			Multiplies NUM_BATCH matrices A[b] by the same B. B stays resident and the A matrices are fed
+//			back to back through one run of the datapath, so the pipeline fill and drain is paid once
+//			per batch instead of once per matrix (see matrix_multiply_cycles).
+//			- A[][][] - NUM_BATCH input A matrices
+//			- B[][]   - B input 2 dimensional matrix, shared by the whole batch
+//			- C[][][] - NUM_BATCH output C matrices
+//			A stream of A matrices is batched the same way by matrix_multiply_stream with t_rowsA = NUM_BATCH * rows.
+//
+// matrix_multiply_stream
+//			Same template arguments, but A arrives on an ihc::stream_in in row-major order and C leaves
+//			on an ihc::stream_out in row-major order. Only B is held on chip. Rows of A are consumed
+//			while the previous row of C is being computed and every element of C is written as soon
+//			as it is final, so neither A nor C is ever buffered as a whole.
+//			- A    -  stream_in carrying t_rowsA * t_colsA elements
+//			- B[][] - B input 2 dimensional matrix
+//			- C    -  stream_out receiving t_rowsA * t_colsB elements
+//
+// matrix_multiply_planned
+//			matrix_multiply with DOT_VEC_SIZE, BLOCK_SIZE and RUNNING_SUM_MULT_L chosen at compile time by
+//			matmul_plan<T, t_rowsA, t_colsA, t_colsB, DSP_BUDGET, MEM_BW>:
+//			- DOT_VEC_SIZE            - the largest factor of t_colsA whose multipliers fit into DSP_BUDGET,
+//			                            which minimizes matrix_multiply_cycles
+//			- BLOCK_SIZE              - the smallest factor of DOT_VEC_SIZE, at most MEM_BW (elements of A read
+//			                            per clock cycle), that still loads a row of A within a row of C
+//			- RUNNING_SUM_MULT_L      - enough running sums to cover the accumulation latency of T
+//			DSPs per multiplier and the addition latency of T come from matmul_multiplier_dsps<T> and
+//			matmul_adder_latency<T>, which can be specialized for other types or devices.
+//			matmul_plan<...>::CYCLES and ::DSPS give the expected schedule length and DSP usage.
+//
+// matrix_multiply_tiled
+//			A, B and C of any size in external memory, read and written through mm_master interfaces
+//			(row-major). C is computed one TILE_ROWSA x TILE_COLSB tile at a time, as the sum over
+//			TILE_ROWSA x TILE_COLSA tiles of A times TILE_COLSA x TILE_COLSB tiles of B, each product
+//			computed by the same dot-product schedule as matrix_multiply with DOT_VEC_SIZE, BLOCK_SIZE and
+//			RUNNING_SUM_MULT_L applying to the tile. The A and B tiles and the C tile are double buffered:
+//			while the schedule runs on one pair, the next A and B tiles are burst-read into the other and
+//			the previous C tile is written back, one element per iteration of the schedule loop, so memory
+//			transfers are hidden behind computation as long as
+//			    TILE_ROWSA*TILE_COLSA + TILE_COLSA*TILE_COLSB + TILE_ROWSA*TILE_COLSB <= matrix_multiply_cycles<TILE_ROWSA, TILE_COLSA, TILE_COLSB, DOT_VEC_SIZE>()
+//			t_rowsA, t_colsA and t_colsB must be multiples of the corresponding tile size.
+//			- A - mm_master of t_rowsA * t_colsA elements
+//			- B - mm_master of t_colsA * t_colsB elements
+//			- C - mm_master of t_rowsA * t_colsB elements
+//
+// matrix_multiply_mixed
+//			matrix_multiply with independent types for the operands, the accumulation and the result:
+//			- TA, TB                  - Data types of the elements of A and B, they set the width of the multipliers
+//			- TACC                    - Data type of the running sums, the products of TA and TB are added in TACC
+//			- TC                      - Data type of the elements of C, converted from TACC when C is stored
+//			e.g. ac_fixed<8,1,true> inputs accumulated in ac_fixed<24,9,true> and stored as ac_fixed<16,4,true>.
+//			TACC must be constructible from 0 and TC from TACC.
+//
+// matrix_multiply_layout
+//			matrix_multiply with B stored in one of the matrix_layout layouts. Every clock cycle the schedule
+//			reads DOT_VEC_SIZE consecutive rows of one column of B. In a row-major B these are DOT_VEC_SIZE
+//			different words, so B has to be split into DOT_VEC_SIZE banks (or replicated). In the other
+//			layouts they are DOT_VEC_SIZE adjacent elements, so B is a single memory of DOT_VEC_SIZE wide words.
+//			- MATRIX_LAYOUT_ROW_MAJOR - B[t_colsA][t_colsB], as matrix_multiply
+//			- MATRIX_LAYOUT_COL_MAJOR - B[t_colsB][t_colsA], i.e. a row-major pre-transposed B
+//			- MATRIX_LAYOUT_BLOCKED   - B[t_colsA / DOT_VEC_SIZE][t_colsB][DOT_VEC_SIZE], the words in the order
+//			                            the schedule reads them
+//			matrix_pack_b converts a row-major B into any of the layouts, e.g. in the testbench.
+//
+// matrix_vector_multiply
+//			A x = y, the t_colsB == 1 case without the machinery for many B columns. x is held in
+//			DOT_VEC_SIZE banks (registers when DOT_VEC_SIZE == t_colsA) and A is read in row-major order,
+//			DOT_VEC_SIZE elements per clock cycle. The DOT_VEC_SIZE products are reduced by a balanced
+//			adder tree, so with DOT_VEC_SIZE == t_colsA one row is completed every clock cycle.
+//			Otherwise a row takes t_colsA / DOT_VEC_SIZE cycles and the chunks of a row are folded into
+//			RUNNING_SUM_MULT_L interleaved running sums; set it to the latency of an addition to keep II=1.
+//			DOT_VEC_SIZE must divide t_colsA and RUNNING_SUM_MULT_L be at most t_colsA / DOT_VEC_SIZE.
+//			- A[][] - A input 2 dimensional matrix, t_rowsA x t_colsA
+//			- x[]   - input vector, t_colsA elements
+//			- y[]   - output vector, t_rowsA elements
+//
 //Tip - You can safely ignore compiler warnings like default template arguments for a function template are a C++11 extension [-Wc++11-extensions]. 
-template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
-void matrix_multiply(T A_local[t_rowsA][t_colsA], T B_local[t_colsA][t_colsB], T C_local[t_colsA][t_colsB]) {
-	const int COLSA = t_colsA;
-	const int ROWSA = t_rowsA;
-	const int COLSB = t_colsB;
-	const int ROWSB = COLSA;
-	const int ROWSC = ROWSA;
-	const int COLSC = COLSB;
-
-	const int num_iter_per_elem_L = (COLSA / DOT_VEC_SIZE);
-
-	T A_local_regs[DOT_VEC_SIZE], A_local_regs_stable[DOT_VEC_SIZE];
-
-	//partial_products represents a memory with depth COLSC
-	T running_sums_for_col[COLSC * RUNNING_SUM_MULT_L];
-
-	int i, j, s; // make sure these variables are within bounds of the corresponding comparisons in code below.
-	i = -1;
-	j = 0;
-	s = num_iter_per_elem_L - 1;
-	for (int k = 0; k < num_iter_per_elem_L * COLSC * ROWSC + COLSC; ++k) {
-		bool last_s_itr = s == num_iter_per_elem_L - 1;
-		// load the cache
-
-		// latch A_local_regs
-		if (j == 0) {
+namespace matrix_mult_internal {
+	constexpr int min_int(int a, int b) { return a < b ? a : b; }
+	constexpr int max_int(int a, int b) { return a > b ? a : b; }
+
+	// Balanced adder tree over N values, log2(N) additions deep
+	template<class T, int N>
+	struct adder_tree {
+		static T sum(const T *v) {
+			return adder_tree<T, N / 2>::sum(v) + adder_tree<T, N - N / 2>::sum(v + N / 2);
+		}
+	};
+
+	template<class T>
+	struct adder_tree<T, 1> {
+		static T sum(const T *v) { return v[0]; }
+	};
+
+	// Element accessors used by the dot-product engine below. A sources are read in row-major order,
+	// exactly once per element, so a source may also be a stream.
+	template<class T, int COLS>
+	struct array_source {
+		T (*m)[COLS];
+		T operator()(int row, int col) const { return m[row][col]; }
+	};
+
+	// Converts the accumulated value to the element type of C on store
+	template<class T, int COLS>
+	struct array_sink {
+		T (*m)[COLS];
+		template<class V>
+		void operator()(int row, int col, const V &val) const { m[row][col] = static_cast<T>(val); }
+	};
+
+	template<class T, class... Params>
+	struct stream_source {
+		ihc::stream_in<T, Params...> &s;
+		T operator()(int, int) const { return s.read(); }
+	};
+
+	template<class T, class... Params>
+	struct stream_sink {
+		ihc::stream_out<T, Params...> &s;
+		void operator()(int, int, const T &val) const { s.write(val); }
+	};
+
+	// Adds the results into C, or overwrites it for the first partial product of a tile
+	template<class T, int COLS>
+	struct accumulate_sink {
+		T (*m)[COLS];
+		bool first;
+		void operator()(int row, int col, const T &val) const { m[row][col] = first ? val : m[row][col] + val; }
+	};
+
+	struct no_side_task {
+		void operator()(int) const {}
+	};
+
+	// Rejects configurations the schedule cannot compute correctly
+	template<int t_colsA, int t_colsB, int DOT_VEC_SIZE, int BLOCK_SIZE, int RUNNING_SUM_MULT_L>
+	void check_params() {
+		static_assert(DOT_VEC_SIZE > 0 && t_colsA % DOT_VEC_SIZE == 0, "DOT_VEC_SIZE must be a factor of t_colsA");
+		static_assert(BLOCK_SIZE > 0 && DOT_VEC_SIZE % BLOCK_SIZE == 0, "BLOCK_SIZE must be a factor of DOT_VEC_SIZE");
+		static_assert(DOT_VEC_SIZE / BLOCK_SIZE <= t_colsB, "a row of A cannot be loaded within a row of C, increase BLOCK_SIZE");
+		static_assert(RUNNING_SUM_MULT_L >= 1 && RUNNING_SUM_MULT_L <= t_colsA / DOT_VEC_SIZE,
+		              "RUNNING_SUM_MULT_L must be between 1 and t_colsA / DOT_VEC_SIZE");
+	}
+
+	// Cycle-accurate hardware schedule shared by all matrix_multiply variants. Elements of A are held
+	// in registers of type TA, products are accumulated in TACC.
+	//   a(row, col)      - element of A, called once per element in row-major order
+	//   b(row, col)      - element of B
+	//   c(row, col, val) - receives C in row-major order as soon as each element is final
+	//   side(k)          - called in every iteration k, for work that has to overlap with the computation
+	template<class TA, class TACC, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE, int BLOCK_SIZE, int RUNNING_SUM_MULT_L,
+	         class ASource, class BSource, class CSink, class SideTask>
+	void dot_product_engine(const ASource &a, const BSource &b, const CSink &c, const SideTask &side) {
+		const int COLSA = t_colsA;
+		const int ROWSA = t_rowsA;
+		const int COLSB = t_colsB;
+		const int ROWSC = ROWSA;
+		const int COLSC = COLSB;
+
+		const int num_iter_per_elem_L = (COLSA / DOT_VEC_SIZE);
+		check_params<t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>();
+
+		TA A_local_regs[DOT_VEC_SIZE], A_local_regs_stable[DOT_VEC_SIZE];
+
+		//partial_products represents a memory with depth COLSC
+		TACC running_sums_for_col[COLSC * RUNNING_SUM_MULT_L];
+
+		int i, j, s; // make sure these variables are within bounds of the corresponding comparisons in code below.
+		i = -1;
+		j = 0;
+		s = num_iter_per_elem_L - 1;
+		for (int k = 0; k < num_iter_per_elem_L * COLSC * ROWSC + COLSC; ++k) {
+			side(k);
+			bool last_s_itr = s == num_iter_per_elem_L - 1;
+			// load the cache
+
+			// latch A_local_regs
+			if (j == 0) {
 #pragma unroll
-			for (int d = 0; d < DOT_VEC_SIZE; d++) {
-				A_local_regs_stable[d] = A_local_regs[d];
+				for (int d = 0; d < DOT_VEC_SIZE; d++) {
+					A_local_regs_stable[d] = A_local_regs[d];
+				}
 			}
-		}
 #pragma unroll
-		for (int d = 0; d < DOT_VEC_SIZE - BLOCK_SIZE; ++d) {
-			A_local_regs[d] = A_local_regs[d + BLOCK_SIZE];
-		}
-		// Start loading a new full row of A, once end of an output row is approaching
-		// BLOCKS elements of the row are loaded concurrently
+			for (int d = 0; d < DOT_VEC_SIZE - BLOCK_SIZE; ++d) {
+				A_local_regs[d] = A_local_regs[d + BLOCK_SIZE];
+			}
+			// Start loading a new full row of A, once end of an output row is approaching
+			// BLOCKS elements of the row are loaded concurrently
 #pragma unroll
-		for (int d = 0; d < BLOCK_SIZE; ++d) {
-			T val;
-			if (j >= COLSC - DOT_VEC_SIZE / BLOCK_SIZE) {
-				//When padding is zero ((BLOCKS + BLOCKS_PADDING) * VEC_BLOCK_RATIO) == DOT_VECTOR_SIZE
-				int rowA, colA;
-				if ((s + 1) * DOT_VEC_SIZE == COLSA) {
-					rowA = i + 1;
-					colA = (j - COLSC + DOT_VEC_SIZE / BLOCK_SIZE) * BLOCK_SIZE + d;
+			for (int d = 0; d < BLOCK_SIZE; ++d) {
+				TA val;
+				if (j >= COLSC - DOT_VEC_SIZE / BLOCK_SIZE) {
+					//When padding is zero ((BLOCKS + BLOCKS_PADDING) * VEC_BLOCK_RATIO) == DOT_VECTOR_SIZE
+					int rowA, colA;
+					if ((s + 1) * DOT_VEC_SIZE == COLSA) {
+						rowA = i + 1;
+						colA = (j - COLSC + DOT_VEC_SIZE / BLOCK_SIZE) * BLOCK_SIZE + d;
+					} else {
+						rowA = i;
+						colA = (s + 1) * DOT_VEC_SIZE + (j - COLSC + DOT_VEC_SIZE / BLOCK_SIZE) * BLOCK_SIZE + d;
+					}
+					// the last pass would prefetch the row after the last one
+					if (rowA < ROWSA) {
+						val = a(rowA, colA);
+					}
+				}
+				A_local_regs[d + DOT_VEC_SIZE - BLOCK_SIZE] = val;
+			}
+			// compute partial products
+			TACC running_sum = (TACC) 0;
+#pragma unroll
+			for (int d = 0; d < DOT_VEC_SIZE; ++d) {
+				running_sum += A_local_regs_stable[d] * b(s * DOT_VEC_SIZE + d, j);
+			}
+			TACC sum = running_sums_for_col[RUNNING_SUM_MULT_L * COLSC - 1] = (s < RUNNING_SUM_MULT_L ? (TACC) 0 : running_sums_for_col[RUNNING_SUM_MULT_L * COLSC - 1]) + running_sum;
+			TACC final_sum = sum;
+#pragma unroll
+			for (int d = 1; d < RUNNING_SUM_MULT_L; d++) {
+				final_sum += running_sums_for_col[(RUNNING_SUM_MULT_L - d) * COLSC - 1];
+			}
+			// rotate running sums
+			TACC tmp = running_sums_for_col[0];
+#pragma unroll
+			for (int d = 0; d < RUNNING_SUM_MULT_L * COLSC - 1; d++) {
+				running_sums_for_col[d] = running_sums_for_col[d + 1];
+			}
+			// only rotate if we need to
+			// this should remove the false dependency on the
+			// result of the partial addition
+			if (num_iter_per_elem_L > RUNNING_SUM_MULT_L) {
+				running_sums_for_col[RUNNING_SUM_MULT_L * COLSC - 1] = tmp;
+			} else {
+				running_sums_for_col[RUNNING_SUM_MULT_L * COLSC - 1] = (TACC) 0; // MATRIX_ELEMENT_ZERO;
+			}
+
+			if (last_s_itr && i >= 0) {
+				c(i, j, final_sum);
+			}
+			if (j == COLSC - 1) {
+				j = 0;
+				if (last_s_itr) {
+					s = 0;
+					i++;
 				} else {
-					rowA = i;
-					colA = (s + 1) * DOT_VEC_SIZE + (j - COLSC + DOT_VEC_SIZE / BLOCK_SIZE) * BLOCK_SIZE + d;
+					s++;
+				}
+			} else {
+				j++;
+			}
+		}
+	}
+
+	template<class TA, class TACC, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE, int BLOCK_SIZE, int RUNNING_SUM_MULT_L,
+	         class ASource, class BSource, class CSink>
+	void dot_product_engine(const ASource &a, const BSource &b, const CSink &c) {
+		dot_product_engine<TA, TACC, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c, no_side_task());
+	}
+}
+
+// Cycle-accurate hardware schedule, used for synthesis
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+void matrix_multiply_schedule(T A_local[t_rowsA][t_colsA], T B_local[t_colsA][t_colsB], T C_local[t_rowsA][t_colsB]) {
+	matrix_mult_internal::array_source<T, t_colsA> a = {A_local};
+	matrix_mult_internal::array_source<T, t_colsB> b = {B_local};
+	matrix_mult_internal::array_sink<T, t_colsB> c = {C_local};
+	matrix_mult_internal::dot_product_engine<T, T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c);
+}
+
+#ifdef HLS_X86
+namespace matrix_mult_internal {
+	// Number of B columns processed per panel so that a t_colsA x COLS panel of B stays in cache
+	template<class T, int t_colsA, int t_colsB>
+	struct x86_panel {
+		enum { COLS = min_int(t_colsB, min_int(1024, max_int(16, (int)(MATRIX_MULT_X86_PANEL_BYTES / (t_colsA * sizeof(T)))))) };
+	};
+}
+
+// Cache-blocked x86 kernel. For every output element it forms the same DOT_VEC_SIZE wide partial
+// sums as the hardware schedule and folds them into RUNNING_SUM_MULT_L interleaved running sums,
+// but evaluates a whole panel of output columns at once so the inner loops are unit-stride.
+// Results are handed to c(row, col, val) in row-major order.
+template<class TA, class TB, class TACC, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE, int RUNNING_SUM_MULT_L, class CSink>
+void matrix_multiply_x86_kernel(TA A_local[t_rowsA][t_colsA], TB B_local[t_colsA][t_colsB], const CSink &c) {
+	static_assert(DOT_VEC_SIZE > 0 && t_colsA % DOT_VEC_SIZE == 0, "DOT_VEC_SIZE must be a factor of t_colsA");
+	static_assert(RUNNING_SUM_MULT_L >= 1 && RUNNING_SUM_MULT_L <= t_colsA / DOT_VEC_SIZE,
+	              "RUNNING_SUM_MULT_L must be between 1 and t_colsA / DOT_VEC_SIZE");
+	const int num_iter_per_elem_L = (t_colsA / DOT_VEC_SIZE);
+	const int L = RUNNING_SUM_MULT_L;
+	const int PANEL = matrix_mult_internal::x86_panel<TB, t_colsA, t_colsB>::COLS;
+
+	TACC partial[PANEL];
+	TACC running_sums[L][PANEL];
+
+	for (int jj = 0; jj < t_colsB; jj += PANEL) {
+		const int cols = matrix_mult_internal::min_int(PANEL, t_colsB - jj);
+		for (int i = 0; i < t_rowsA; ++i) {
+			for (int s = 0; s < num_iter_per_elem_L; ++s) {
+				for (int j = 0; j < cols; ++j) {
+					partial[j] = (TACC) 0;
+				}
+				for (int d = 0; d < DOT_VEC_SIZE; ++d) {
+					const TA a = A_local[i][s * DOT_VEC_SIZE + d];
+					const TB *b = &B_local[s * DOT_VEC_SIZE + d][jj];
+					for (int j = 0; j < cols; ++j) {
+						partial[j] += a * b[j];
+					}
+				}
+				TACC *sums = running_sums[s % L];
+				for (int j = 0; j < cols; ++j) {
+					sums[j] = (s < L ? (TACC) 0 : sums[j]) + partial[j];
 				}
-				val = A_local[rowA][colA];
 			}
-			A_local_regs[d + DOT_VEC_SIZE - BLOCK_SIZE] = val;
+			const int last_s = num_iter_per_elem_L - 1;
+			for (int j = 0; j < cols; ++j) {
+				TACC final_sum = running_sums[last_s % L][j];
+				for (int d = 1; d < L; d++) {
+					final_sum += running_sums[(last_s - d) % L][j];
+				}
+				c(i, jj + j, final_sum);
+			}
 		}
-		// compute partial products
-		T running_sum = 0.0f;
+	}
+}
+
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int RUNNING_SUM_MULT_L = 1>
+void matrix_multiply_x86(T A_local[t_rowsA][t_colsA], T B_local[t_colsA][t_colsB], T C_local[t_rowsA][t_colsB]) {
+	matrix_mult_internal::array_sink<T, t_colsB> c = {C_local};
+	matrix_multiply_x86_kernel<T, T, T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, c);
+}
+#endif
+
+#if defined(HLS_X86) && defined(MATRIX_MULT_VERIFY)
+namespace matrix_mult_internal {
+	// MATRIX_MULT_VERIFY: reports the elements where C of the x86 kernel and C of the hardware schedule
+	// differ and stops with an error if there are any
+	template<class TC, int t_rowsA, int t_colsB>
+	void verify(const char *name, TC C_local[t_rowsA][t_colsB], TC C_schedule[t_rowsA][t_colsB]) {
+		int mismatches = 0;
+		for (int i = 0; i < t_rowsA; ++i) {
+			for (int j = 0; j < t_colsB; ++j) {
+				if (!(C_local[i][j] == C_schedule[i][j])) {
+					if (mismatches < 10) {
+						printf("%s: C[%d][%d] differs between x86 kernel and hardware schedule\n", name, i, j);
+					}
+					mismatches++;
+				}
+			}
+		}
+		if (mismatches) {
+			printf("%s: %d of %d elements differ\n", name, mismatches, t_rowsA * t_colsB);
+			char msg[128];
+			snprintf(msg, sizeof(msg), "%s verification failed (MATRIX_MULT_VERIFY)", name);
+			__ihc_hls_runtime_error_x86(msg);
+		}
+	}
+}
+#endif
+
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+void matrix_multiply(T A_local[t_rowsA][t_colsA], T B_local[t_colsA][t_colsB], T C_local[t_rowsA][t_colsB]) {
+	matrix_mult_internal::check_params<t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>();
+#if defined(HLS_X86) && defined(MATRIX_MULT_VERIFY)
+	static T C_schedule[t_rowsA][t_colsB];
+	matrix_multiply_schedule<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, C_schedule);
+	matrix_multiply_x86<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, C_local);
+	matrix_mult_internal::verify<T, t_rowsA, t_colsB>("matrix_multiply", C_local, C_schedule);
+#elif defined(HLS_X86) && !defined(MATRIX_MULT_EMULATE_SCHEDULE)
+	matrix_multiply_x86<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, C_local);
+#else
+	matrix_multiply_schedule<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, C_local);
+#endif
+}
+
+// Iterations of the hardware schedule (clock cycles once the loop is pipelined with II=1) for a run over
+// num_batch A matrices. The trailing t_colsB iterations are the pipeline fill and drain.
+template<int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA>
+constexpr long long matrix_multiply_cycles(int num_batch = 1) {
+	return (long long)(t_colsA / DOT_VEC_SIZE) * t_colsB * t_rowsA * num_batch + t_colsB;
+}
+
+// DSPs used by one multiplier of T
+template<class T> struct matmul_multiplier_dsps { enum { value = 1 }; };
+template<> struct matmul_multiplier_dsps<double> { enum { value = 4 }; };
+
+// Clock cycles to add two values of T
+template<class T> struct matmul_adder_latency { enum { value = 1 }; };
+template<> struct matmul_adder_latency<float> { enum { value = 4 }; };
+template<> struct matmul_adder_latency<double> { enum { value = 8 }; };
+
+namespace matrix_mult_internal {
+	constexpr int plan_block_size(int dot_vec_size, int colsB, int mem_bw) {
+		for (int b = 1; b <= dot_vec_size && b <= mem_bw; ++b) {
+			if (dot_vec_size % b == 0 && dot_vec_size / b <= colsB) {
+				return b;
+			}
+		}
+		return 0;
+	}
+
+	constexpr int plan_dot_vec_size(int colsA, int colsB, int max_multipliers, int mem_bw) {
+		for (int d = min_int(colsA, max_multipliers); d > 1; --d) {
+			if (colsA % d == 0 && plan_block_size(d, colsB, mem_bw) > 0) {
+				return d;
+			}
+		}
+		return 1;
+	}
+
+	constexpr int plan_running_sum_mult_l(int num_iter_per_elem_L, int colsB, int adder_latency) {
+		return min_int(num_iter_per_elem_L, max_int(1, (adder_latency + colsB - 1) / colsB));
+	}
+}
+
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int DSP_BUDGET, int MEM_BW = t_colsA>
+struct matmul_plan {
+	static_assert(t_rowsA > 0 && t_colsA > 0 && t_colsB > 0, "matrix dimensions must be positive");
+	static_assert(DSP_BUDGET >= matmul_multiplier_dsps<T>::value, "DSP_BUDGET does not fit a single multiplier");
+	static_assert(MEM_BW >= 1, "MEM_BW must allow at least one element of A per clock cycle");
+	enum {
+		DOT_VEC_SIZE = matrix_mult_internal::plan_dot_vec_size(t_colsA, t_colsB, DSP_BUDGET / matmul_multiplier_dsps<T>::value, MEM_BW),
+		BLOCK_SIZE = matrix_mult_internal::plan_block_size(DOT_VEC_SIZE, t_colsB, MEM_BW),
+		RUNNING_SUM_MULT_L = matrix_mult_internal::plan_running_sum_mult_l(t_colsA / DOT_VEC_SIZE, t_colsB, matmul_adder_latency<T>::value),
+		DSPS = DOT_VEC_SIZE * matmul_multiplier_dsps<T>::value
+	};
+	static constexpr long long CYCLES = matrix_multiply_cycles<t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE>();
+};
+
+template<class T, int NUM_BATCH, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+void matrix_multiply_batched(T A_local[NUM_BATCH][t_rowsA][t_colsA], T B_local[t_colsA][t_colsB], T C_local[NUM_BATCH][t_rowsA][t_colsB]) {
+	// the batch is stored contiguously, so it is the same schedule over one A with NUM_BATCH * t_rowsA rows
+	matrix_multiply<T, NUM_BATCH * t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(
+		reinterpret_cast<T (*)[t_colsA]>(A_local), B_local, reinterpret_cast<T (*)[t_colsB]>(C_local));
+}
+
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1,
+         class... AParams, class... CParams>
+void matrix_multiply_stream(ihc::stream_in<T, AParams...> &A, T B_local[t_colsA][t_colsB], ihc::stream_out<T, CParams...> &C) {
+	matrix_mult_internal::check_params<t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>();
+#if defined(HLS_X86) && !defined(MATRIX_MULT_EMULATE_SCHEDULE) && !defined(MATRIX_MULT_VERIFY)
+	// one row at a time through the x86 kernel, same order of stream accesses as the schedule
+	T A_row[1][t_colsA], C_row[1][t_colsB];
+	for (int i = 0; i < t_rowsA; ++i) {
+		for (int k = 0; k < t_colsA; ++k) {
+			A_row[0][k] = A.read();
+		}
+		matrix_multiply_x86<T, 1, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_row, B_local, C_row);
+		for (int j = 0; j < t_colsB; ++j) {
+			C.write(C_row[0][j]);
+		}
+	}
+#else
+	matrix_mult_internal::stream_source<T, AParams...> a = {A};
+	matrix_mult_internal::array_source<T, t_colsB> b = {B_local};
+	matrix_mult_internal::stream_sink<T, CParams...> c = {C};
+	matrix_mult_internal::dot_product_engine<T, T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c);
+#endif
+}
+
+template<class TA, class TB, class TACC, class TC, int t_rowsA, int t_colsA, int t_colsB,
+         int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+void matrix_multiply_mixed(TA A_local[t_rowsA][t_colsA], TB B_local[t_colsA][t_colsB], TC C_local[t_rowsA][t_colsB]) {
+	matrix_mult_internal::check_params<t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>();
+	matrix_mult_internal::array_sink<TC, t_colsB> c = {C_local};
+#if defined(HLS_X86) && defined(MATRIX_MULT_VERIFY)
+	static TC C_schedule[t_rowsA][t_colsB];
+	matrix_mult_internal::array_source<TA, t_colsA> a = {A_local};
+	matrix_mult_internal::array_source<TB, t_colsB> b = {B_local};
+	matrix_mult_internal::array_sink<TC, t_colsB> c_schedule = {C_schedule};
+	matrix_mult_internal::dot_product_engine<TA, TACC, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c_schedule);
+	matrix_multiply_x86_kernel<TA, TB, TACC, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, c);
+	matrix_mult_internal::verify<TC, t_rowsA, t_colsB>("matrix_multiply_mixed", C_local, C_schedule);
+#elif defined(HLS_X86) && !defined(MATRIX_MULT_EMULATE_SCHEDULE)
+	matrix_multiply_x86_kernel<TA, TB, TACC, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, c);
+#else
+	matrix_mult_internal::array_source<TA, t_colsA> a = {A_local};
+	matrix_mult_internal::array_source<TB, t_colsB> b = {B_local};
+	matrix_mult_internal::dot_product_engine<TA, TACC, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c);
+#endif
+}
+
+enum matrix_layout { MATRIX_LAYOUT_ROW_MAJOR, MATRIX_LAYOUT_COL_MAJOR, MATRIX_LAYOUT_BLOCKED };
+
+// Storage of a t_colsA x t_colsB matrix B in each layout
+template<class T, matrix_layout LAYOUT, int t_colsA, int t_colsB, int DOT_VEC_SIZE>
+struct matrix_b_storage;
+
+template<class T, int t_colsA, int t_colsB, int DOT_VEC_SIZE>
+struct matrix_b_storage<T, MATRIX_LAYOUT_ROW_MAJOR, t_colsA, t_colsB, DOT_VEC_SIZE> {
+	typedef T (*type)[t_colsB];
+	static T &at(type m, int row, int col) { return m[row][col]; }
+};
+
+template<class T, int t_colsA, int t_colsB, int DOT_VEC_SIZE>
+struct matrix_b_storage<T, MATRIX_LAYOUT_COL_MAJOR, t_colsA, t_colsB, DOT_VEC_SIZE> {
+	typedef T (*type)[t_colsA];
+	static T &at(type m, int row, int col) { return m[col][row]; }
+};
+
+template<class T, int t_colsA, int t_colsB, int DOT_VEC_SIZE>
+struct matrix_b_storage<T, MATRIX_LAYOUT_BLOCKED, t_colsA, t_colsB, DOT_VEC_SIZE> {
+	typedef T (*type)[t_colsB][DOT_VEC_SIZE];
+	static T &at(type m, int row, int col) { return m[row / DOT_VEC_SIZE][col][row % DOT_VEC_SIZE]; }
+};
+
+namespace matrix_mult_internal {
+	template<class T, matrix_layout LAYOUT, int t_colsA, int t_colsB, int DOT_VEC_SIZE>
+	struct layout_source {
+		typedef matrix_b_storage<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE> storage;
+		typename storage::type m;
+		T operator()(int row, int col) const { return storage::at(m, row, col); }
+	};
+
+#ifdef HLS_X86
+	// B in row-major order for the x86 kernel, unpacked into a buffer of its own for every call
+	template<class T, matrix_layout LAYOUT, int t_colsA, int t_colsB, int DOT_VEC_SIZE>
+	struct row_major_b {
+		typedef matrix_b_storage<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE> storage;
+		T (*m)[t_colsB];
+		explicit row_major_b(typename storage::type b) : m(new T[t_colsA][t_colsB]) {
+			for (int k = 0; k < t_colsA; ++k) {
+				for (int j = 0; j < t_colsB; ++j) {
+					m[k][j] = storage::at(b, k, j);
+				}
+			}
+		}
+		~row_major_b() { delete[] m; }
+	private:
+		row_major_b(const row_major_b &);
+		row_major_b &operator=(const row_major_b &);
+	};
+
+	// a row-major B is used as it is
+	template<class T, int t_colsA, int t_colsB, int DOT_VEC_SIZE>
+	struct row_major_b<T, MATRIX_LAYOUT_ROW_MAJOR, t_colsA, t_colsB, DOT_VEC_SIZE> {
+		T (*m)[t_colsB];
+		explicit row_major_b(T (*b)[t_colsB]) : m(b) {}
+	};
+#endif
+}
+
+template<class T, matrix_layout LAYOUT, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA>
+void matrix_pack_b(T B_local[t_colsA][t_colsB], typename matrix_b_storage<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE>::type B_packed) {
+	for (int k = 0; k < t_colsA; ++k) {
+		for (int j = 0; j < t_colsB; ++j) {
+			matrix_b_storage<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE>::at(B_packed, k, j) = B_local[k][j];
+		}
+	}
+}
+
+// Cycle-accurate hardware schedule, used for synthesis
+template<class T, matrix_layout LAYOUT, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+void matrix_multiply_layout_schedule(T A_local[t_rowsA][t_colsA], typename matrix_b_storage<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE>::type B_local,
+                                     T C_local[t_rowsA][t_colsB]) {
+	matrix_mult_internal::array_source<T, t_colsA> a = {A_local};
+	matrix_mult_internal::layout_source<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE> b = {B_local};
+	matrix_mult_internal::array_sink<T, t_colsB> c = {C_local};
+	matrix_mult_internal::dot_product_engine<T, T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c);
+}
+
+template<class T, matrix_layout LAYOUT, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+void matrix_multiply_layout(T A_local[t_rowsA][t_colsA], typename matrix_b_storage<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE>::type B_local,
+                            T C_local[t_rowsA][t_colsB]) {
+	matrix_mult_internal::check_params<t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>();
+#if defined(HLS_X86) && defined(MATRIX_MULT_VERIFY)
+	// the schedule reads B in its layout, the x86 kernel from the row-major copy
+	static T C_schedule[t_rowsA][t_colsB];
+	matrix_multiply_layout_schedule<T, LAYOUT, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, C_schedule);
+	const matrix_mult_internal::row_major_b<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE> b(B_local);
+	matrix_multiply_x86<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_local, b.m, C_local);
+	matrix_mult_internal::verify<T, t_rowsA, t_colsB>("matrix_multiply_layout", C_local, C_schedule);
+#elif defined(HLS_X86) && !defined(MATRIX_MULT_EMULATE_SCHEDULE)
+	// the x86 kernel wants unit-stride rows of B
+	const matrix_mult_internal::row_major_b<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE> b(B_local);
+	matrix_multiply_x86<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_local, b.m, C_local);
+#else
+	matrix_multiply_layout_schedule<T, LAYOUT, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, C_local);
+#endif
+}
+
+template<class T, int t_rowsA, int t_colsA, int DOT_VEC_SIZE = t_colsA, int RUNNING_SUM_MULT_L = 1>
+void matrix_vector_multiply(T A_local[t_rowsA][t_colsA], T x[t_colsA], T y[t_rowsA]) {
+	// the checks of check_params that do not involve BLOCK_SIZE and t_colsB
+	static_assert(DOT_VEC_SIZE > 0 && t_colsA % DOT_VEC_SIZE == 0, "DOT_VEC_SIZE must be a factor of t_colsA");
+	static_assert(RUNNING_SUM_MULT_L >= 1 && RUNNING_SUM_MULT_L <= t_colsA / DOT_VEC_SIZE,
+	              "RUNNING_SUM_MULT_L must be between 1 and t_colsA / DOT_VEC_SIZE");
+	const int num_iter_per_elem_L = (t_colsA / DOT_VEC_SIZE);
+	const int L = RUNNING_SUM_MULT_L;
+
+	// one bank per lane of the dot product
+	T x_local[num_iter_per_elem_L][DOT_VEC_SIZE];
+	for (int s = 0; s < num_iter_per_elem_L; ++s) {
 #pragma unroll
 		for (int d = 0; d < DOT_VEC_SIZE; ++d) {
-			running_sum += A_local_regs_stable[d] * B_local[s * DOT_VEC_SIZE + d][j];
+			x_local[s][d] = x[s * DOT_VEC_SIZE + d];
 		}
-		T sum = running_sums_for_col[RUNNING_SUM_MULT_L * COLSC - 1] = (s < RUNNING_SUM_MULT_L ? 0.0f : running_sums_for_col[RUNNING_SUM_MULT_L * COLSC - 1]) + running_sum;
-		T final_sum = sum;
+	}
+
+	// running_sums[0] is the newest, a new chunk is added to the one from L iterations earlier
+	T running_sums[L];
+	int i = 0;
+	int s = 0;
+	for (int k = 0; k < t_rowsA * num_iter_per_elem_L; ++k) {
+		T products[DOT_VEC_SIZE];
 #pragma unroll
-		for (int d = 1; d < RUNNING_SUM_MULT_L; d++) {
-			final_sum += running_sums_for_col[(RUNNING_SUM_MULT_L - d) * COLSC - 1];
+		for (int d = 0; d < DOT_VEC_SIZE; ++d) {
+			products[d] = A_local[i][s * DOT_VEC_SIZE + d] * x_local[s][d];
 		}
-		// rotate running sums
-		T tmp = running_sums_for_col[0];
+		T sum = (s < L ? (T) 0 : running_sums[L - 1]) + matrix_mult_internal::adder_tree<T, DOT_VEC_SIZE>::sum(products);
 #pragma unroll
-		for (int d = 0; d < RUNNING_SUM_MULT_L * COLSC - 1; d++) {
-			running_sums_for_col[d] = running_sums_for_col[d + 1];
-		}
-		// only rotate if we need to
-		// this should remove the false dependency on the
-		// result of the partial addition
-		if (num_iter_per_elem_L > RUNNING_SUM_MULT_L) {
-			running_sums_for_col[RUNNING_SUM_MULT_L * COLSC - 1] = tmp;
+		for (int d = L - 1; d > 0; d--) {
+			running_sums[d] = running_sums[d - 1];
+		}
+		running_sums[0] = sum;
+		if (s == num_iter_per_elem_L - 1) {
+			y[i] = matrix_mult_internal::adder_tree<T, L>::sum(running_sums);
+			s = 0;
+			i++;
 		} else {
-			running_sums_for_col[RUNNING_SUM_MULT_L * COLSC - 1] = (T) 0.0; // MATRIX_ELEMENT_ZERO;
+			s++;
 		}
+	}
+}
 
-		if (last_s_itr && i >= 0) {
-			(C_local)[i][j] = final_sum;
-		}
-		if (j == COLSC - 1) {
-			j = 0;
-			if (last_s_itr) {
-				s = 0;
-				i++;
-			} else {
-				s++;
+namespace matrix_mult_internal {
+	// Side task of matrix_multiply_tiled. Element k of the transfer is, in this order, an element of
+	// the next A tile, of the next B tile or of the finished C tile.
+	template<class T, int TILE_ROWSA, int TILE_COLSA, int TILE_COLSB, class AMaster, class BMaster, class CMaster>
+	struct tile_transfer {
+		enum {
+			A_ELEMS = TILE_ROWSA * TILE_COLSA,
+			B_ELEMS = TILE_COLSA * TILE_COLSB,
+			C_ELEMS = TILE_ROWSA * TILE_COLSB,
+			SIZE = A_ELEMS + B_ELEMS + C_ELEMS
+		};
+		AMaster &A;
+		BMaster &B;
+		CMaster &C;
+		int colsA, colsB;          // row pitch of A and of B and C in memory
+		bool load, store;
+		T (*A_next)[TILE_COLSA];
+		T (*B_next)[TILE_COLSB];
+		T (*C_done)[TILE_COLSB];
+		int a_offset, b_offset, c_offset;
+
+		void operator()(int k) const {
+			if (k < A_ELEMS) {
+				const int row = k / TILE_COLSA, col = k % TILE_COLSA;
+				if (load) {
+					A_next[row][col] = A[a_offset + row * colsA + col];
+				}
+			} else if (k < A_ELEMS + B_ELEMS) {
+				const int row = (k - A_ELEMS) / TILE_COLSB, col = (k - A_ELEMS) % TILE_COLSB;
+				if (load) {
+					B_next[row][col] = B[b_offset + row * colsB + col];
+				}
+			} else if (k < SIZE) {
+				const int row = (k - A_ELEMS - B_ELEMS) / TILE_COLSB, col = (k - A_ELEMS - B_ELEMS) % TILE_COLSB;
+				if (store) {
+					C[c_offset + row * colsB + col] = C_done[row][col];
+				}
 			}
-		} else {
-			j++;
 		}
+	};
+}
+
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int TILE_ROWSA, int TILE_COLSA, int TILE_COLSB,
+         int DOT_VEC_SIZE = TILE_COLSA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1,
+         class... AParams, class... BParams, class... CParams>
+void matrix_multiply_tiled(ihc::mm_master<T, AParams...> &A, ihc::mm_master<T, BParams...> &B, ihc::mm_master<T, CParams...> &C) {
+	static_assert(t_rowsA % TILE_ROWSA == 0 && t_colsA % TILE_COLSA == 0 && t_colsB % TILE_COLSB == 0,
+	              "matrix dimensions must be multiples of the tile dimensions");
+	matrix_mult_internal::check_params<TILE_COLSA, TILE_COLSB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>();
+	const int TILES_I = t_rowsA / TILE_ROWSA;
+	const int TILES_J = t_colsB / TILE_COLSB;
+	const int TILES_K = t_colsA / TILE_COLSA;
+	const int STEPS = TILES_I * TILES_J * TILES_K;
+	typedef matrix_mult_internal::tile_transfer<T, TILE_ROWSA, TILE_COLSA, TILE_COLSB,
+	                                            ihc::mm_master<T, AParams...>, ihc::mm_master<T, BParams...>, ihc::mm_master<T, CParams...> > transfer;
+
+	T A_buf[2][TILE_ROWSA][TILE_COLSA];
+	T B_buf[2][TILE_COLSA][TILE_COLSB];
+	T C_buf[2][TILE_ROWSA][TILE_COLSB];
+
+	transfer xfer = {A, B, C, t_colsA, t_colsB, true, false, A_buf[0], B_buf[0], C_buf[0], 0, 0, 0};
+	for (int k = 0; k < transfer::A_ELEMS + transfer::B_ELEMS; ++k) {
+		xfer(k);
 	}
+
+	for (int t = 0; t < STEPS; ++t) {
+		const int tk = t % TILES_K;
+		const int tile = t / TILES_K;
+		const int ti = tile / TILES_J, tj = tile % TILES_J;
+		T (*C_tile)[TILE_COLSB] = C_buf[tile & 1];
+
+		// prefetch the tiles of step t + 1
+		const int next_tk = (t + 1) % TILES_K;
+		const int next_tile = (t + 1) / TILES_K;
+		const int next_ti = next_tile / TILES_J, next_tj = next_tile % TILES_J;
+		xfer.load = t + 1 < STEPS;
+		xfer.A_next = A_buf[(t + 1) & 1];
+		xfer.B_next = B_buf[(t + 1) & 1];
+		xfer.a_offset = next_ti * TILE_ROWSA * t_colsA + next_tk * TILE_COLSA;
+		xfer.b_offset = next_tk * TILE_COLSA * t_colsB + next_tj * TILE_COLSB;
+		// write back the previous C tile once a new one is started
+		const int prev_tile = tile - 1;
+		xfer.store = tk == 0 && tile > 0;
+		xfer.C_done = C_buf[(tile + 1) & 1];
+		xfer.c_offset = (prev_tile / TILES_J) * TILE_ROWSA * t_colsB + (prev_tile % TILES_J) * TILE_COLSB;
+
+		matrix_mult_internal::accumulate_sink<T, TILE_COLSB> c = {C_tile, tk == 0};
+#if defined(HLS_X86) && !defined(MATRIX_MULT_EMULATE_SCHEDULE)
+		for (int k = 0; k < transfer::SIZE; ++k) {
+			xfer(k);
+		}
+		matrix_multiply_x86_kernel<T, T, T, TILE_ROWSA, TILE_COLSA, TILE_COLSB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_buf[t & 1], B_buf[t & 1], c);
+#else
+		matrix_mult_internal::array_source<T, TILE_COLSA> a = {A_buf[t & 1]};
+		matrix_mult_internal::array_source<T, TILE_COLSB> b = {B_buf[t & 1]};
+		matrix_mult_internal::dot_product_engine<T, T, TILE_ROWSA, TILE_COLSA, TILE_COLSB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c, xfer);
+		// transfers that did not fit into the schedule
+		for (int k = matrix_multiply_cycles<TILE_ROWSA, TILE_COLSA, TILE_COLSB, DOT_VEC_SIZE>(); k < transfer::SIZE; ++k) {
+			xfer(k);
+		}
+#endif
+	}
+
+	// write back the last C tile
+	const int last_tile = TILES_I * TILES_J - 1;
+	xfer.load = false;
+	xfer.store = true;
+	xfer.C_done = C_buf[last_tile & 1];
+	xfer.c_offset = (last_tile / TILES_J) * TILE_ROWSA * t_colsB + (last_tile % TILES_J) * TILE_COLSB;
+	for (int k = transfer::A_ELEMS + transfer::B_ELEMS; k < transfer::SIZE; ++k) {
+		xfer(k);
+	}
+}
+
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int DSP_BUDGET, int MEM_BW = t_colsA>
+void matrix_multiply_planned(T A_local[t_rowsA][t_colsA], T B_local[t_colsA][t_colsB], T C_local[t_rowsA][t_colsB]) {
+	typedef matmul_plan<T, t_rowsA, t_colsA, t_colsB, DSP_BUDGET, MEM_BW> plan;
+	matrix_multiply<T, t_rowsA, t_colsA, t_colsB, plan::DOT_VEC_SIZE, plan::BLOCK_SIZE, plan::RUNNING_SUM_MULT_L>(A_local, B_local, C_local);
 }
 
+#endif //__HLS_MATRIX_MULT_H__
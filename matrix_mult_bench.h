@@ -0,0 +1,361 @@
+#ifndef __HLS_MATRIX_MULT_BENCH_H__
+#define __HLS_MATRIX_MULT_BENCH_H__
+
+///////////////////////////////////////////////////////////////////////////////
+// Matrix Multiplication Benchmarks
+//
+// Reports for the matrix_multiply variants, built on the component benchmark
+// harness (HLS/hls_bench.h). Every line carries the modeled schedule length
+// per matrix (matrix_multiply_cycles) next to the measured numbers, so the
+// emulation flow shows the cycle effect of a configuration and a cosimulation
+// run confirms it.
+//
+//   // x86 emulation: single vs batched on the same data
+//   ihc::bench::matmul_batched<float, 64, 4, 16, 16, 4>(100);
+//
+//   // cosimulation: a component computing 64 matrices per invocation
+//   ihc::bench::result r = ihc::bench::run_component(dut, inputs, 100, "dut");
+//   ihc::bench::report_matmul(r, 64, matrix_multiply_cycles<4, 16, 16, 4>(64));
+//
+//   // x86 emulation: sparse CSR / CSC vs dense at 2% density
+//   ihc::bench::matmul_sparse<float, 256, 256, 16, 16>(0.02, 100);
+//
+//   // parameter sweep, one CSV row per configuration
+//   ihc::bench::matmul_sweep<float, ihc::bench::matmul_config<64, 64, 64, 8, 4, 2>,
+//                                   ihc::bench::matmul_config<64, 64, 64, 16, 16, 1> >(10);
+//   ihc::bench::matmul_sweep_default<float>(10);   // built-in grid
+//
+//   // B layouts, hardware schedule in emulation
+//   ihc::bench::matmul_layouts<float, 64, 64, 64, 16>(10);
+///////////////////////////////////////////////////////////////////////////////
+
+#include "HLS/hls_bench.h"
+#include "HLS/matrix_mult.h"
+#include "HLS/sparse_matrix_mult.h"
+#include <limits>
+#include <stdlib.h>
+
+namespace ihc {
+namespace bench {
+
+struct matmul_result {
+  const char *name;
+  int matrices;                        // total A matrices multiplied
+  double model_cycles_per_matrix;      // from matrix_multiply_cycles
+  double wall_seconds;
+  double matrices_per_second;
+  double cycles_per_matrix;            // measured, 0 when not simulated
+};
+
+inline void report(const matmul_result &r, FILE *f = stdout) {
+  fprintf(f, "{\"name\":\"%s\",\"matrices\":%d,\"model_cycles_per_matrix\":%.6g,"
+             "\"wall_seconds\":%.9g,\"matrices_per_second\":%.9g,\"cycles_per_matrix\":%.6g}\n",
+          r.name, r.matrices, r.model_cycles_per_matrix,
+          r.wall_seconds, r.matrices_per_second, r.cycles_per_matrix);
+}
+
+// Converts a run_component result for a component that multiplies
+// matrices_per_invocation matrices into per-matrix figures
+inline matmul_result per_matrix(const result &r, int matrices_per_invocation, long long model_cycles_per_invocation) {
+  matmul_result m;
+  m.name = r.name;
+  m.matrices = r.invocations * matrices_per_invocation;
+  m.model_cycles_per_matrix = (double)model_cycles_per_invocation / matrices_per_invocation;
+  m.wall_seconds = r.wall_seconds;
+  m.matrices_per_second = r.invocations_per_second * matrices_per_invocation;
+  m.cycles_per_matrix = 0.0;
+  if (r.simulated) {
+    // back to back invocations overlap, so the steady state cost is the II
+    m.cycles_per_matrix = r.ii_cycles / matrices_per_invocation;
+  }
+  return m;
+}
+
+inline void report_matmul(const result &r, int matrices_per_invocation, long long model_cycles_per_invocation, FILE *f = stdout) {
+  report(per_matrix(r, matrices_per_invocation, model_cycles_per_invocation), f);
+}
+
+namespace internal {
+
+  template<class T>
+  void fill_random(T *p, int n) {
+    for (int i = 0; i < n; i++) {
+      p[i] = (T)((rand() % 2001 - 1000) / 64.0);
+    }
+  }
+
+  inline double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  inline matmul_result matmul_emulated(const char *name, int matrices, long long model_cycles, double seconds) {
+    matmul_result m;
+    m.name = name;
+    m.matrices = matrices;
+    m.model_cycles_per_matrix = (double)model_cycles / matrices;
+    m.wall_seconds = seconds;
+    m.matrices_per_second = seconds > 0.0 ? matrices / seconds : 0.0;
+    m.cycles_per_matrix = 0.0;
+    return m;
+  }
+
+} // namespace internal
+
+// Multiplies batches * NUM_BATCH random A matrices by one B, once with a
+// matrix_multiply call per matrix and once with matrix_multiply_batched per
+// batch, and reports both
+template<class T, int NUM_BATCH, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+void matmul_batched(int batches, FILE *f = stdout) {
+  std::vector<T> A(NUM_BATCH * t_rowsA * t_colsA), B(t_colsA * t_colsB), C(NUM_BATCH * t_rowsA * t_colsB);
+  internal::fill_random(&A[0], (int)A.size());
+  internal::fill_random(&B[0], (int)B.size());
+  T (*a)[t_rowsA][t_colsA] = reinterpret_cast<T (*)[t_rowsA][t_colsA]>(&A[0]);
+  T (*b)[t_colsB] = reinterpret_cast<T (*)[t_colsB]>(&B[0]);
+  T (*c)[t_rowsA][t_colsB] = reinterpret_cast<T (*)[t_rowsA][t_colsB]>(&C[0]);
+  const int matrices = batches * NUM_BATCH;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int n = 0; n < batches; n++) {
+    for (int m = 0; m < NUM_BATCH; m++) {
+      matrix_multiply<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a[m], b, c[m]);
+    }
+  }
+  report(internal::matmul_emulated("matrix_multiply", matrices,
+                                   matrix_multiply_cycles<t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE>(1) * matrices,
+                                   internal::seconds_since(start)), f);
+
+  start = std::chrono::steady_clock::now();
+  for (int n = 0; n < batches; n++) {
+    matrix_multiply_batched<T, NUM_BATCH, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c);
+  }
+  report(internal::matmul_emulated("matrix_multiply_batched", matrices,
+                                   matrix_multiply_cycles<t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE>(NUM_BATCH) * batches,
+                                   internal::seconds_since(start)), f);
+}
+
+// Multiplies a random t_rowsA x t_colsA matrix A with the given density of
+// nonzeros by a dense B, iterations times each with the dense
+// matrix_multiply and the sparse spmm_csr / spmm_csc, and reports all three
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA>
+void matmul_sparse(double density, int iterations, FILE *f = stdout) {
+  std::vector<T> A(t_rowsA * t_colsA), B(t_colsA * t_colsB), C(t_rowsA * t_colsB);
+  internal::fill_random(&A[0], (int)A.size());
+  internal::fill_random(&B[0], (int)B.size());
+  for (size_t i = 0; i < A.size(); i++) {
+    if (rand() >= density * RAND_MAX) {
+      A[i] = 0;
+    }
+  }
+
+  std::vector<T> csr_values, csc_values;
+  std::vector<int> csr_idx, csr_ptr(1, 0), csc_idx, csc_ptr(1, 0);
+  for (int r = 0; r < t_rowsA; r++) {
+    for (int c = 0; c < t_colsA; c++) {
+      if (A[r * t_colsA + c] != 0) {
+        csr_values.push_back(A[r * t_colsA + c]);
+        csr_idx.push_back(c);
+      }
+    }
+    csr_ptr.push_back((int)csr_values.size());
+  }
+  for (int c = 0; c < t_colsA; c++) {
+    for (int r = 0; r < t_rowsA; r++) {
+      if (A[r * t_colsA + c] != 0) {
+        csc_values.push_back(A[r * t_colsA + c]);
+        csc_idx.push_back(r);
+      }
+    }
+    csc_ptr.push_back((int)csc_values.size());
+  }
+  const int nnz = (int)csr_values.size();
+  // keep the interfaces valid for an all-zero A
+  csr_values.resize(nnz + 1);
+  csr_idx.resize(nnz + 1);
+  csc_values.resize(nnz + 1);
+  csc_idx.resize(nnz + 1);
+
+  T (*a)[t_colsA] = reinterpret_cast<T (*)[t_colsA]>(&A[0]);
+  T (*b)[t_colsB] = reinterpret_cast<T (*)[t_colsB]>(&B[0]);
+  T (*c)[t_colsB] = reinterpret_cast<T (*)[t_colsB]>(&C[0]);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int n = 0; n < iterations; n++) {
+    matrix_multiply<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE>(a, b, c);
+  }
+  report(internal::matmul_emulated("matrix_multiply", iterations,
+                                   matrix_multiply_cycles<t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE>(1) * iterations,
+                                   internal::seconds_since(start)), f);
+
+  mm_master<T> mm_b(&B[0], B.size() * sizeof(T)), mm_c(&C[0], C.size() * sizeof(T));
+  mm_master<T> mm_csr_values(&csr_values[0], csr_values.size() * sizeof(T));
+  mm_master<int> mm_csr_idx(&csr_idx[0], csr_idx.size() * sizeof(int)), mm_csr_ptr(&csr_ptr[0], csr_ptr.size() * sizeof(int));
+  // the sparse kernels copy B on chip, their cycle models count that
+  start = std::chrono::steady_clock::now();
+  for (int n = 0; n < iterations; n++) {
+    spmm_csr<T, t_rowsA, t_colsA, t_colsB>(mm_csr_values, mm_csr_idx, mm_csr_ptr, mm_b, mm_c);
+  }
+  report(internal::matmul_emulated("spmm_csr", iterations,
+                                   spmm_csr_cycles<t_rowsA, t_colsA>(nnz) * iterations,
+                                   internal::seconds_since(start)), f);
+
+  mm_master<T> mm_csc_values(&csc_values[0], csc_values.size() * sizeof(T));
+  mm_master<int> mm_csc_idx(&csc_idx[0], csc_idx.size() * sizeof(int)), mm_csc_ptr(&csc_ptr[0], csc_ptr.size() * sizeof(int));
+  start = std::chrono::steady_clock::now();
+  for (int n = 0; n < iterations; n++) {
+    spmm_csc<T, t_rowsA, t_colsA, t_colsB>(mm_csc_values, mm_csc_idx, mm_csc_ptr, mm_b, mm_c);
+  }
+  report(internal::matmul_emulated("spmm_csc", iterations,
+                                   spmm_csc_cycles<t_rowsA, t_colsA>(nnz) * iterations,
+                                   internal::seconds_since(start)), f);
+}
+
+// One point of a parameter sweep
+template<int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+struct matmul_config {};
+
+inline void matmul_sweep_header(FILE *f = stdout) {
+  fprintf(f, "rows_a,cols_a,cols_b,dot_vec_size,block_size,running_sum_mult_l,valid,iterations,"
+             "wall_seconds,seconds_per_call,model_cycles,dsps,max_rel_error,correct\n");
+}
+
+namespace internal {
+
+  // Configurations matrix_multiply rejects at compile time are not instantiated
+  template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE, int BLOCK_SIZE, int RUNNING_SUM_MULT_L>
+  void matmul_sweep_run(matmul_config<t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>,
+                        std::false_type, int, FILE *f) {
+    fprintf(f, "0,0,0,0,0,0,0\n");
+  }
+
+  // Runs one configuration and compares the result against a double precision reference
+  template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE, int BLOCK_SIZE, int RUNNING_SUM_MULT_L>
+  void matmul_sweep_run(matmul_config<t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>,
+                        std::true_type, int iterations, FILE *f) {
+    std::vector<T> A(t_rowsA * t_colsA), B(t_colsA * t_colsB), C(t_rowsA * t_colsB);
+    fill_random(&A[0], (int)A.size());
+    fill_random(&B[0], (int)B.size());
+    T (*a)[t_colsA] = reinterpret_cast<T (*)[t_colsA]>(&A[0]);
+    T (*b)[t_colsB] = reinterpret_cast<T (*)[t_colsB]>(&B[0]);
+    T (*c)[t_colsB] = reinterpret_cast<T (*)[t_colsB]>(&C[0]);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++) {
+      matrix_multiply<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c);
+    }
+    const double seconds = seconds_since(start);
+
+    // error relative to the magnitude of the summed products, which bounds the rounding error
+    double max_rel_error = 0.0;
+    for (int i = 0; i < t_rowsA; i++) {
+      for (int j = 0; j < t_colsB; j++) {
+        double sum = 0.0, magnitude = 0.0;
+        for (int k = 0; k < t_colsA; k++) {
+          const double p = (double)a[i][k] * (double)b[k][j];
+          sum += p;
+          magnitude += p < 0 ? -p : p;
+        }
+        const double error = (double)c[i][j] - sum;
+        const double rel = magnitude > 0.0 ? (error < 0 ? -error : error) / magnitude : (error != 0.0);
+        max_rel_error = rel > max_rel_error ? rel : max_rel_error;
+      }
+    }
+    // a few ulps of T per accumulation step
+    const double tolerance = 4.0 * t_colsA * (double)std::numeric_limits<T>::epsilon();
+
+    fprintf(f, "%d,%.9g,%.9g,%lld,%d,%.3g,%d\n", iterations, seconds, iterations > 0 ? seconds / iterations : 0.0,
+            matrix_multiply_cycles<t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE>(), DOT_VEC_SIZE,
+            max_rel_error, max_rel_error <= tolerance ? 1 : 0);
+  }
+
+  template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE, int BLOCK_SIZE, int RUNNING_SUM_MULT_L>
+  void matmul_sweep_point(matmul_config<t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L> config,
+                          int iterations, FILE *f) {
+    typedef std::integral_constant<bool, (DOT_VEC_SIZE > 0 && t_colsA % DOT_VEC_SIZE == 0 &&
+                                          BLOCK_SIZE > 0 && DOT_VEC_SIZE % BLOCK_SIZE == 0 &&
+                                          DOT_VEC_SIZE / BLOCK_SIZE <= t_colsB &&
+                                          RUNNING_SUM_MULT_L >= 1 && RUNNING_SUM_MULT_L <= t_colsA / DOT_VEC_SIZE)> valid;
+    fprintf(f, "%d,%d,%d,%d,%d,%d,%d,", t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L, valid::value ? 1 : 0);
+    matmul_sweep_run<T>(config, valid(), iterations, f);
+  }
+
+} // namespace internal
+
+// Writes a CSV header and one row per configuration: emulation time of
+// matrix_multiply, the schedule length from matrix_multiply_cycles, the number
+// of multipliers (DOT_VEC_SIZE) and whether the result matches a reference.
+// Invalid combinations are listed with valid=0 and not run.
+template<class T, class... Configs>
+void matmul_sweep(int iterations, FILE *f = stdout) {
+  matmul_sweep_header(f);
+  int expand[] = {0, (internal::matmul_sweep_point<T>(Configs(), iterations, f), 0)...};
+  (void)expand;
+}
+
+// Sizes 16, 64 and 128 over the DOT_VEC_SIZE, BLOCK_SIZE and RUNNING_SUM_MULT_L trade-offs
+template<class T>
+void matmul_sweep_default(int iterations, FILE *f = stdout) {
+  matmul_sweep<T,
+      matmul_config<16, 16, 16, 16, 16, 1>, matmul_config<16, 16, 16, 4, 4, 1>,
+      matmul_config<16, 16, 16, 4, 2, 2>, matmul_config<16, 16, 16, 2, 2, 4>,
+      matmul_config<64, 64, 64, 64, 64, 1>, matmul_config<64, 64, 64, 16, 16, 1>,
+      matmul_config<64, 64, 64, 16, 8, 2>, matmul_config<64, 64, 64, 8, 8, 4>,
+      matmul_config<64, 64, 64, 8, 2, 8>, matmul_config<64, 64, 64, 4, 4, 4>,
+      matmul_config<128, 128, 128, 32, 32, 1>, matmul_config<128, 128, 128, 16, 16, 2>,
+      matmul_config<128, 128, 128, 8, 4, 4>, matmul_config<128, 16, 128, 8, 8, 1> >(iterations, f);
+}
+
+namespace internal {
+
+  template<class T, matrix_layout LAYOUT, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE, int BLOCK_SIZE, int RUNNING_SUM_MULT_L>
+  void matmul_layout_point(const char *layout, T (*a)[t_colsA], T (*b)[t_colsB], T (*reference)[t_colsB], int iterations, FILE *f) {
+    typedef matrix_b_storage<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE> storage;
+    std::vector<T> packed(t_colsA * t_colsB), C(t_rowsA * t_colsB);
+    typename storage::type b_packed = reinterpret_cast<typename storage::type>(&packed[0]);
+    T (*c)[t_colsB] = reinterpret_cast<T (*)[t_colsB]>(&C[0]);
+    matrix_pack_b<T, LAYOUT, t_colsA, t_colsB, DOT_VEC_SIZE>(b, b_packed);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int n = 0; n < iterations; n++) {
+      matrix_multiply_layout_schedule<T, LAYOUT, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b_packed, c);
+    }
+    const double seconds = seconds_since(start);
+    bool correct = true;
+    for (int i = 0; i < t_rowsA; i++) {
+      for (int j = 0; j < t_colsB; j++) {
+        correct = correct && c[i][j] == reference[i][j];
+      }
+    }
+    // memories needed to read DOT_VEC_SIZE elements of B per clock cycle, and their word width
+    const int banks = LAYOUT == MATRIX_LAYOUT_ROW_MAJOR ? DOT_VEC_SIZE : 1;
+    fprintf(f, "{\"name\":\"matrix_multiply_layout\",\"layout\":\"%s\",\"iterations\":%d,\"wall_seconds\":%.9g,"
+               "\"b_banks\":%d,\"b_word_elements\":%d,\"b_bank_depth\":%d,\"correct\":%s}\n",
+            layout, iterations, seconds, banks, DOT_VEC_SIZE / banks, t_colsA * t_colsB / DOT_VEC_SIZE,
+            correct ? "true" : "false");
+  }
+
+} // namespace internal
+
+// Runs the hardware schedule of matrix_multiply_layout on the same random
+// operands once per B layout, and reports the emulation time, the on-chip
+// memory organization B needs and whether the result matches the row-major run
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1>
+void matmul_layouts(int iterations, FILE *f = stdout) {
+  std::vector<T> A(t_rowsA * t_colsA), B(t_colsA * t_colsB), C(t_rowsA * t_colsB);
+  internal::fill_random(&A[0], (int)A.size());
+  internal::fill_random(&B[0], (int)B.size());
+  T (*a)[t_colsA] = reinterpret_cast<T (*)[t_colsA]>(&A[0]);
+  T (*b)[t_colsB] = reinterpret_cast<T (*)[t_colsB]>(&B[0]);
+  T (*c)[t_colsB] = reinterpret_cast<T (*)[t_colsB]>(&C[0]);
+  matrix_multiply_schedule<T, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c);
+
+  internal::matmul_layout_point<T, MATRIX_LAYOUT_ROW_MAJOR, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(
+      "row_major", a, b, c, iterations, f);
+  internal::matmul_layout_point<T, MATRIX_LAYOUT_COL_MAJOR, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(
+      "col_major", a, b, c, iterations, f);
+  internal::matmul_layout_point<T, MATRIX_LAYOUT_BLOCKED, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(
+      "blocked", a, b, c, iterations, f);
+}
+
+} // namespace bench
+} // namespace ihc
+
+#endif //__HLS_MATRIX_MULT_BENCH_H__
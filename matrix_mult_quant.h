@@ -0,0 +1,101 @@
+#ifndef __HLS_MATRIX_MULT_QUANT_H__
+#define __HLS_MATRIX_MULT_QUANT_H__
+
+#include "HLS/ac_int.h"
+#include "HLS/matrix_mult.h"
+
+// Quantized integer matrix multiplication on ac_int. A x B = C
+// Runs the same schedule as matrix_multiply (see HLS/matrix_mult.h for the template arguments),
+// but with narrow integer inputs, an exact integer accumulator and a fused requantization step:
+//			- A and B elements are ac_int<WA,SA> and ac_int<WB,SB>, e.g. int8 or int4.
+//			  Only the WA x WB multipliers are built, not multipliers of the accumulator width.
+//			- Products are summed in the accumulator
+//			      ac_int<WA,SA>::rt<WB,SB>::mult::rt_unary::set<t_colsA>::sum
+//			  which is the product width plus log2(t_colsA) bits, so the sum of a whole row of A times
+//			  a column of B cannot overflow.
+//			- Each output column j (output channel) is requantized as
+//			      C[i][j] = saturate((acc * scale[j] + 2^(shift[j]-1)) >> shift[j])
+//			  i.e. scaled, shifted right with round half up and saturated to ac_int<WO,SO>.
+//			  shift[j] must be smaller than the width of acc * scale[j].
+//
+// function arguments
+//			- A[][]   -  A input 2 dimensional matrix
+//			- B[][]   -  B input 2 dimensional matrix
+//			- scale[] -  per output column multiplier
+//			- shift[] -  per output column right shift
+//			- C[][]   -  C output 2 dimensional matrix
+//
+// example - int8 inputs and outputs, 16 bit scale:
+//			int8 A[4][64], B[64][16], C[4][16];
+//			ac_int<16,true> scale[16];
+//			ac_int<5,false> shift[16];
+//			matrix_multiply_quant<4, 64, 16, 8>(A, B, scale, shift, C);
+//
+// Integer accumulation is exact, so in x86 emulation the cache-blocked kernel and the hardware
+// schedule (MATRIX_MULT_EMULATE_SCHEDULE) give the same C. MATRIX_MULT_VERIFY runs both and checks it,
+// as for matrix_multiply.
+
+namespace matrix_mult_internal {
+	// Accumulator for the sum of K products of ac_int<WA,SA> * ac_int<WB,SB>
+	template<int WA, bool SA, int WB, bool SB, int K>
+	struct quant_types {
+		typedef typename ac_int<WA, SA>::template rt<WB, SB>::mult product;
+		typedef typename product::rt_unary::template set<K>::sum accum;
+	};
+
+	template<int WO, bool SO, int WACC, bool SACC, int WS, bool SS, int WSH>
+	ac_int<WO, SO> requantize(const ac_int<WACC, SACC> &acc, const ac_int<WS, SS> &scale, const ac_int<WSH, false> &shift) {
+		typedef typename ac_int<WACC, SACC>::template rt<WS, SS>::mult scaled_t;
+		// one extra bit so adding the rounding constant cannot overflow
+		typedef ac_int<scaled_t::width + 1, scaled_t::sign> rounded_t;
+		const ac_int<WO, SO> out_max = value<AC_VAL_MAX>(ac_int<WO, SO>(0));
+		const ac_int<WO, SO> out_min = value<AC_VAL_MIN>(ac_int<WO, SO>(0));
+
+		rounded_t r = acc * scale;
+		// (1 << shift) >> 1 is the rounding constant, and 0 for shift == 0
+		r += ((rounded_t) 1 << shift) >> 1;
+		r >>= shift;
+		if (r > out_max) {
+			return out_max;
+		}
+		if (r < out_min) {
+			return out_min;
+		}
+		return r;
+	}
+
+	template<int WO, bool SO, int COLS, int WS, bool SS, int WSH>
+	struct requant_sink {
+		ac_int<WO, SO> (*m)[COLS];
+		ac_int<WS, SS> *scale;
+		ac_int<WSH, false> *shift;
+		template<class TACC>
+		void operator()(int row, int col, const TACC &acc) const { m[row][col] = requantize<WO, SO>(acc, scale[col], shift[col]); }
+	};
+}
+
+template<int t_rowsA, int t_colsA, int t_colsB, int DOT_VEC_SIZE = t_colsA, int BLOCK_SIZE = DOT_VEC_SIZE, int RUNNING_SUM_MULT_L = 1,
+         int WA, bool SA, int WB, bool SB, int WS, bool SS, int WSH, int WO, bool SO>
+void matrix_multiply_quant(ac_int<WA, SA> A_local[t_rowsA][t_colsA], ac_int<WB, SB> B_local[t_colsA][t_colsB],
+                           ac_int<WS, SS> scale[t_colsB], ac_int<WSH, false> shift[t_colsB], ac_int<WO, SO> C_local[t_rowsA][t_colsB]) {
+	matrix_mult_internal::check_params<t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>();
+	typedef typename matrix_mult_internal::quant_types<WA, SA, WB, SB, t_colsA>::accum TACC;
+	matrix_mult_internal::requant_sink<WO, SO, t_colsB, WS, SS, WSH> c = {C_local, scale, shift};
+#if defined(HLS_X86) && defined(MATRIX_MULT_VERIFY)
+	static ac_int<WO, SO> C_schedule[t_rowsA][t_colsB];
+	matrix_mult_internal::array_source<ac_int<WA, SA>, t_colsA> a = {A_local};
+	matrix_mult_internal::array_source<ac_int<WB, SB>, t_colsB> b = {B_local};
+	matrix_mult_internal::requant_sink<WO, SO, t_colsB, WS, SS, WSH> c_schedule = {C_schedule, scale, shift};
+	matrix_mult_internal::dot_product_engine<ac_int<WA, SA>, TACC, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c_schedule);
+	matrix_multiply_x86_kernel<ac_int<WA, SA>, ac_int<WB, SB>, TACC, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, c);
+	matrix_mult_internal::verify<ac_int<WO, SO>, t_rowsA, t_colsB>("matrix_multiply_quant", C_local, C_schedule);
+#elif defined(HLS_X86) && !defined(MATRIX_MULT_EMULATE_SCHEDULE)
+	matrix_multiply_x86_kernel<ac_int<WA, SA>, ac_int<WB, SB>, TACC, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, RUNNING_SUM_MULT_L>(A_local, B_local, c);
+#else
+	matrix_mult_internal::array_source<ac_int<WA, SA>, t_colsA> a = {A_local};
+	matrix_mult_internal::array_source<ac_int<WB, SB>, t_colsB> b = {B_local};
+	matrix_mult_internal::dot_product_engine<ac_int<WA, SA>, TACC, t_rowsA, t_colsA, t_colsB, DOT_VEC_SIZE, BLOCK_SIZE, RUNNING_SUM_MULT_L>(a, b, c);
+#endif
+}
+
+#endif //__HLS_MATRIX_MULT_QUANT_H__
@@ -0,0 +1,295 @@
+#ifndef __HLS_SPARSE_MATRIX_MULT_H__
+#define __HLS_SPARSE_MATRIX_MULT_H__
+
+#include "HLS/hls.h"
+
+// This is template library for sparse matrix multiplication, the companion of HLS/matrix_mult.h
+// for operands that are mostly zeros. Only the nonzeros of A are read and multiplied, one per clock
+// cycle, so the cost is proportional to the number of nonzeros instead of ROWS * COLS.
+//
+//			spmv_csr  - y = A x,  A in CSR (compressed sparse row) format
+//			spmm_csr  - C = A B,  A in CSR format, B dense
+//			spmv_csc  - y = A x,  A in CSC (compressed sparse column) format
+//			spmm_csc  - C = A B,  A in CSC format, B dense
+//
+// template arguments
+//			- T                       - Data type of the matrix elements
+//			- ROWS                    - Number of rows of A
+//			- COLS                    - Number of cols of A (therefore number of rows of x / B)
+//			- N                       - Number of cols of B and C (spmm only).
+//			                            One row of B is multiplied per nonzero, so this is the number of DSPs used.
+//			- SPARSE_SUM_L            - Number of interleaved partial sums, default 8.
+//			                            Consecutive nonzeros are added into different partial sums so the
+//			                            accumulation does not limit the II. Set it to at least the latency
+//			                            of an addition of T (1 is enough for integer types).
+//
+// function arguments, all mm_master interfaces
+//			- values  -  nonzero values of A, in row order (CSR) or column order (CSC)
+//			- idx     -  column index (CSR) or row index (CSC) of every nonzero
+//			- ptr     -  ROWS + 1 (CSR) or COLS + 1 (CSC) offsets into values, ptr[0] == 0
+//			- x / B   -  dense input, x[COLS] or B[COLS][N] row-major
+//			- y / C   -  dense output, y[ROWS] or C[ROWS][N] row-major
+//
+// Irregular rows
+//			The nonzero loop is flattened: each iteration either consumes one nonzero or retires one
+//			row (column), so rows of any length, including empty rows, run through a single pipelined
+//			loop of nnz + ROWS (nnz + COLS) iterations without restarting it per row.
+//			The dense operand x / B is copied on chip before the loop, since it is accessed at random.
+//			spmm_csr_cycles and spmm_csc_cycles give the length of the whole kernel.
+//
+// x86 emulation
+//			When HLS_X86 is defined a plain reference implementation is used. Its floating-point
+//			results can differ in the last bits from the hardware schedule, which sums in a different order.
+//			- SPARSE_MULT_EMULATE_SCHEDULE - run the hardware schedule in emulation as well
+
+#ifndef SPARSE_SUM_L_DEFAULT
+#define SPARSE_SUM_L_DEFAULT 8
+#endif
+
+namespace sparse_mult_internal {
+	template<class T, int L>
+	T reduce(T partial[L]) {
+		T sum = partial[0];
+#pragma unroll
+		for (int d = 1; d < L; d++) {
+			sum += partial[d];
+		}
+		return sum;
+	}
+
+	// Schedule iterations for nnz nonzeros over outer rows (CSR) or columns (CSC)
+	inline long long cycles(long long nnz, int outer) {
+		return nnz + outer;
+	}
+}
+
+// Iterations of the loops of spmm_csr (clock cycles once they are pipelined with II=1) for nnz nonzeros:
+// B copied on chip, the row ends loaded and the flattened loop
+template<int ROWS, int COLS>
+inline long long spmm_csr_cycles(long long nnz) {
+	return COLS + ROWS + sparse_mult_internal::cycles(nnz, ROWS);
+}
+
+// Iterations of the loops of spmm_csc for nnz nonzeros: the C banks cleared, the column ends loaded,
+// the flattened loop and the banks reduced into C
+template<int ROWS, int COLS>
+inline long long spmm_csc_cycles(long long nnz) {
+	return ROWS + COLS + sparse_mult_internal::cycles(nnz, COLS) + ROWS;
+}
+
+// Cycle-accurate hardware schedule, used for synthesis
+template<class T, int ROWS, int COLS, int N, int SPARSE_SUM_L = SPARSE_SUM_L_DEFAULT,
+         class... VParams, class... IParams, class... PParams, class... BParams, class... CParams>
+void spmm_csr_schedule(ihc::mm_master<T, VParams...> &values, ihc::mm_master<int, IParams...> &idx, ihc::mm_master<int, PParams...> &ptr,
+                       ihc::mm_master<T, BParams...> &B, ihc::mm_master<T, CParams...> &C) {
+	T B_local[COLS][N];
+	for (int k = 0; k < COLS; ++k) {
+#pragma unroll
+		for (int j = 0; j < N; ++j) {
+			B_local[k][j] = B[k * N + j];
+		}
+	}
+	int row_end_local[ROWS];
+	for (int r = 0; r < ROWS; ++r) {
+		row_end_local[r] = ptr[r + 1];
+	}
+
+	// partial sums form a shift register, a new product is added to the one produced SPARSE_SUM_L iterations ago
+	T partial[SPARSE_SUM_L][N];
+#pragma unroll
+	for (int d = 0; d < SPARSE_SUM_L; d++) {
+#pragma unroll
+		for (int j = 0; j < N; ++j) {
+			partial[d][j] = 0;
+		}
+	}
+	const int nnz = row_end_local[ROWS - 1];
+	int row = 0;
+	int p = ptr[0];
+	int row_end = row_end_local[0];
+	for (int k = 0; k < nnz + ROWS; ++k) {
+		if (p < row_end) {
+			const T a = values[p];
+			const int col = idx[p];
+			T sum[N];
+#pragma unroll
+			for (int j = 0; j < N; ++j) {
+				sum[j] = partial[SPARSE_SUM_L - 1][j] + a * B_local[col][j];
+			}
+#pragma unroll
+			for (int d = SPARSE_SUM_L - 1; d > 0; d--) {
+#pragma unroll
+				for (int j = 0; j < N; ++j) {
+					partial[d][j] = partial[d - 1][j];
+				}
+			}
+#pragma unroll
+			for (int j = 0; j < N; ++j) {
+				partial[0][j] = sum[j];
+			}
+			p++;
+		} else {
+			// retire the row
+#pragma unroll
+			for (int j = 0; j < N; ++j) {
+				T column[SPARSE_SUM_L];
+#pragma unroll
+				for (int d = 0; d < SPARSE_SUM_L; d++) {
+					column[d] = partial[d][j];
+					partial[d][j] = 0;
+				}
+				C[row * N + j] = sparse_mult_internal::reduce<T, SPARSE_SUM_L>(column);
+			}
+			row++;
+			if (row < ROWS) {
+				row_end = row_end_local[row];
+			}
+		}
+	}
+}
+
+// Cycle-accurate hardware schedule, used for synthesis
+template<class T, int ROWS, int COLS, int N, int SPARSE_SUM_L = SPARSE_SUM_L_DEFAULT,
+         class... VParams, class... IParams, class... PParams, class... BParams, class... CParams>
+void spmm_csc_schedule(ihc::mm_master<T, VParams...> &values, ihc::mm_master<int, IParams...> &idx, ihc::mm_master<int, PParams...> &ptr,
+                       ihc::mm_master<T, BParams...> &B, ihc::mm_master<T, CParams...> &C) {
+	// one bank of C per partial sum, consecutive nonzeros update different banks, so an update only
+	// depends on the one SPARSE_SUM_L iterations earlier even when they hit the same row
+	T C_banks[SPARSE_SUM_L][ROWS][N];
+	for (int r = 0; r < ROWS; ++r) {
+#pragma unroll
+		for (int d = 0; d < SPARSE_SUM_L; d++) {
+#pragma unroll
+			for (int j = 0; j < N; ++j) {
+				C_banks[d][r][j] = 0;
+			}
+		}
+	}
+	int col_end_local[COLS];
+	for (int c = 0; c < COLS; ++c) {
+		col_end_local[c] = ptr[c + 1];
+	}
+
+	const int nnz = col_end_local[COLS - 1];
+	int col = 0;
+	int p = ptr[0];
+	int col_end = col_end_local[0];
+	int bank = 0;
+	T b[N];
+#pragma unroll
+	for (int j = 0; j < N; ++j) {
+		b[j] = B[j];
+	}
+#pragma ivdep safelen(SPARSE_SUM_L) array(C_banks)
+	for (int k = 0; k < nnz + COLS; ++k) {
+		if (p < col_end) {
+			const T a = values[p];
+			const int row = idx[p];
+#pragma unroll
+			for (int j = 0; j < N; ++j) {
+				C_banks[bank][row][j] += a * b[j];
+			}
+			bank = bank == SPARSE_SUM_L - 1 ? 0 : bank + 1;
+			p++;
+		} else {
+			// move on to the next column of A and row of B
+			col++;
+			if (col < COLS) {
+				col_end = col_end_local[col];
+#pragma unroll
+				for (int j = 0; j < N; ++j) {
+					b[j] = B[col * N + j];
+				}
+			}
+		}
+	}
+
+	for (int r = 0; r < ROWS; ++r) {
+#pragma unroll
+		for (int j = 0; j < N; ++j) {
+			T column[SPARSE_SUM_L];
+#pragma unroll
+			for (int d = 0; d < SPARSE_SUM_L; d++) {
+				column[d] = C_banks[d][r][j];
+			}
+			C[r * N + j] = sparse_mult_internal::reduce<T, SPARSE_SUM_L>(column);
+		}
+	}
+}
+
+#ifdef HLS_X86
+template<class T, int ROWS, int COLS, int N, class... VParams, class... IParams, class... PParams, class... BParams, class... CParams>
+void spmm_csr_x86(ihc::mm_master<T, VParams...> &values, ihc::mm_master<int, IParams...> &idx, ihc::mm_master<int, PParams...> &ptr,
+                  ihc::mm_master<T, BParams...> &B, ihc::mm_master<T, CParams...> &C) {
+	for (int r = 0; r < ROWS; ++r) {
+		T *c = &C[r * N];
+		for (int j = 0; j < N; ++j) {
+			c[j] = 0;
+		}
+		for (int p = ptr[r]; p < ptr[r + 1]; ++p) {
+			const T a = values[p];
+			const T *b = &B[idx[p] * N];
+			for (int j = 0; j < N; ++j) {
+				c[j] += a * b[j];
+			}
+		}
+	}
+}
+
+template<class T, int ROWS, int COLS, int N, class... VParams, class... IParams, class... PParams, class... BParams, class... CParams>
+void spmm_csc_x86(ihc::mm_master<T, VParams...> &values, ihc::mm_master<int, IParams...> &idx, ihc::mm_master<int, PParams...> &ptr,
+                  ihc::mm_master<T, BParams...> &B, ihc::mm_master<T, CParams...> &C) {
+	for (int i = 0; i < ROWS * N; ++i) {
+		C[i] = 0;
+	}
+	for (int col = 0; col < COLS; ++col) {
+		const T *b = &B[col * N];
+		for (int p = ptr[col]; p < ptr[col + 1]; ++p) {
+			const T a = values[p];
+			T *c = &C[idx[p] * N];
+			for (int j = 0; j < N; ++j) {
+				c[j] += a * b[j];
+			}
+		}
+	}
+}
+#endif
+
+template<class T, int ROWS, int COLS, int N, int SPARSE_SUM_L = SPARSE_SUM_L_DEFAULT,
+         class... VParams, class... IParams, class... PParams, class... BParams, class... CParams>
+void spmm_csr(ihc::mm_master<T, VParams...> &values, ihc::mm_master<int, IParams...> &idx, ihc::mm_master<int, PParams...> &ptr,
+              ihc::mm_master<T, BParams...> &B, ihc::mm_master<T, CParams...> &C) {
+#if defined(HLS_X86) && !defined(SPARSE_MULT_EMULATE_SCHEDULE)
+	spmm_csr_x86<T, ROWS, COLS, N>(values, idx, ptr, B, C);
+#else
+	spmm_csr_schedule<T, ROWS, COLS, N, SPARSE_SUM_L>(values, idx, ptr, B, C);
+#endif
+}
+
+template<class T, int ROWS, int COLS, int N, int SPARSE_SUM_L = SPARSE_SUM_L_DEFAULT,
+         class... VParams, class... IParams, class... PParams, class... BParams, class... CParams>
+void spmm_csc(ihc::mm_master<T, VParams...> &values, ihc::mm_master<int, IParams...> &idx, ihc::mm_master<int, PParams...> &ptr,
+              ihc::mm_master<T, BParams...> &B, ihc::mm_master<T, CParams...> &C) {
+#if defined(HLS_X86) && !defined(SPARSE_MULT_EMULATE_SCHEDULE)
+	spmm_csc_x86<T, ROWS, COLS, N>(values, idx, ptr, B, C);
+#else
+	spmm_csc_schedule<T, ROWS, COLS, N, SPARSE_SUM_L>(values, idx, ptr, B, C);
+#endif
+}
+
+// Matrix-vector products are the N == 1 case
+template<class T, int ROWS, int COLS, int SPARSE_SUM_L = SPARSE_SUM_L_DEFAULT,
+         class... VParams, class... IParams, class... PParams, class... XParams, class... YParams>
+void spmv_csr(ihc::mm_master<T, VParams...> &values, ihc::mm_master<int, IParams...> &idx, ihc::mm_master<int, PParams...> &ptr,
+              ihc::mm_master<T, XParams...> &x, ihc::mm_master<T, YParams...> &y) {
+	spmm_csr<T, ROWS, COLS, 1, SPARSE_SUM_L>(values, idx, ptr, x, y);
+}
+
+template<class T, int ROWS, int COLS, int SPARSE_SUM_L = SPARSE_SUM_L_DEFAULT,
+         class... VParams, class... IParams, class... PParams, class... XParams, class... YParams>
+void spmv_csc(ihc::mm_master<T, VParams...> &values, ihc::mm_master<int, IParams...> &idx, ihc::mm_master<int, PParams...> &ptr,
+              ihc::mm_master<T, XParams...> &x, ihc::mm_master<T, YParams...> &y) {
+	spmm_csc<T, ROWS, COLS, 1, SPARSE_SUM_L>(values, idx, ptr, x, y);
+}
+
+#endif //__HLS_SPARSE_MATRIX_MULT_H__
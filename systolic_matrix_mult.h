@@ -0,0 +1,190 @@
+#ifndef __HLS_SYSTOLIC_MATRIX_MULT_H__
+#define __HLS_SYSTOLIC_MATRIX_MULT_H__
+
+#include "HLS/hls.h"
+#include "HLS/matrix_mult.h"
+#include <stdio.h>
+
+// This is template library for matrix multiplication on an output-stationary systolic array. A x B = C
+// A grid of PE_ROWS x PE_COLS processing elements (PEs) computes a PE_ROWS x PE_COLS block of C at a time,
+// every PE owning one element. Rows of A enter the grid from the left and columns of B from the top, each
+// skewed by one step per row / column, and every PE multiplies the pair it receives, adds it to its element
+// and passes A on to its right and B on to its lower neighbor through __fpga_reg registers. Every PE only
+// talks to its neighbors, so the grid scales to thousands of DSPs without the wide fan-out and adder tree
+// of matrix_multiply.
+//
+// template arguments
+//			- T                       - Data type of the matrix elements
+//			- t_rowsA                 - Number of rows of A, a multiple of PE_ROWS
+//			- t_colsA                 - Number of cols of A (therefore number of rows of B)
+//			- t_colsB                 - Number of cols of B, a multiple of PE_COLS * INTERLEAVE
+//			- PE_ROWS, PE_COLS        - Size of the PE grid, PE_ROWS * PE_COLS multipliers are used
+//			- INTERLEAVE              - Number of blocks of C every PE works on in turn, default 1.
+//			                            A PE adds to the same element only every INTERLEAVE clock cycles,
+//			                            set it to the latency of an addition of T to keep II=1 (e.g. for float).
+//			                            The links between PEs become INTERLEAVE registers deep.
+//
+// function arguments
+//			- A[][] -  A input 2 dimensional matrix, PE_ROWS elements of different rows are read per clock cycle
+//			- B[][] -  B input 2 dimensional matrix, PE_COLS elements of different rows are read per clock cycle
+//			- C[][] -  C output 2 dimensional matrix
+//
+// A block of C takes (t_colsA + PE_ROWS + PE_COLS - 2) * INTERLEAVE clock cycles, the skew fills and drains
+// the grid, plus PE_ROWS * INTERLEAVE clock cycles to store it. Every C element is summed in the order of
+// increasing k, so the results equal those of matrix_multiply with DOT_VEC_SIZE = 1.
+//
+// x86 emulation
+//			When HLS_X86 is defined the cache-blocked kernel of matrix_multiply is used instead of stepping
+//			through the grid, unless MATRIX_MULT_EMULATE_SCHEDULE is defined.
+//			matrix_multiply_systolic_model reports the clock cycles and the utilization of every PE.
+
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int PE_ROWS, int PE_COLS, int INTERLEAVE = 1>
+void matrix_multiply_systolic_schedule(T A_local[t_rowsA][t_colsA], T B_local[t_colsA][t_colsB], T C_local[t_rowsA][t_colsB]) {
+	const int BLOCK_ROWS = t_rowsA / PE_ROWS;
+	const int BLOCK_GROUPS = t_colsB / (PE_COLS * INTERLEAVE);
+	const int STEPS = t_colsA + PE_ROWS + PE_COLS - 2;
+
+	T acc[PE_ROWS][PE_COLS][INTERLEAVE];
+	// a_link[p][q] carries A from PE (p, q) to PE (p, q + 1), b_link[p][q] B from PE (p, q) to PE (p + 1, q)
+	T a_link[PE_ROWS][PE_COLS][INTERLEAVE];
+	T b_link[PE_ROWS][PE_COLS][INTERLEAVE];
+#pragma unroll
+	for (int p = 0; p < PE_ROWS; p++) {
+#pragma unroll
+		for (int q = 0; q < PE_COLS; q++) {
+#pragma unroll
+			for (int d = 0; d < INTERLEAVE; d++) {
+				a_link[p][q][d] = 0;
+				b_link[p][q][d] = 0;
+			}
+		}
+	}
+
+	for (int bi = 0; bi < BLOCK_ROWS; ++bi) {
+		for (int bg = 0; bg < BLOCK_GROUPS; ++bg) {
+#pragma unroll
+			for (int p = 0; p < PE_ROWS; p++) {
+#pragma unroll
+				for (int q = 0; q < PE_COLS; q++) {
+#pragma unroll
+					for (int d = 0; d < INTERLEAVE; d++) {
+						acc[p][q][d] = 0;
+					}
+				}
+			}
+
+			// step is the position in the skewed stream, ii the block of the group
+			int step = 0;
+			int ii = 0;
+			for (int t = 0; t < STEPS * INTERLEAVE; ++t) {
+				T a_in[PE_ROWS], b_in[PE_COLS];
+#pragma unroll
+				for (int p = 0; p < PE_ROWS; p++) {
+					const int k = step - p;
+					a_in[p] = (k >= 0 && k < t_colsA) ? A_local[bi * PE_ROWS + p][k] : (T) 0;
+				}
+#pragma unroll
+				for (int q = 0; q < PE_COLS; q++) {
+					const int k = step - q;
+					b_in[q] = (k >= 0 && k < t_colsA) ? B_local[k][(bg * INTERLEAVE + ii) * PE_COLS + q] : (T) 0;
+				}
+
+				// the links deliver what the neighbor consumed INTERLEAVE iterations ago, i.e. one step earlier
+				T a_out[PE_ROWS][PE_COLS], b_out[PE_ROWS][PE_COLS];
+#pragma unroll
+				for (int p = 0; p < PE_ROWS; p++) {
+#pragma unroll
+					for (int q = 0; q < PE_COLS; q++) {
+						const T a = q == 0 ? a_in[p] : a_link[p][q - 1][INTERLEAVE - 1];
+						const T b = p == 0 ? b_in[q] : b_link[p - 1][q][INTERLEAVE - 1];
+						acc[p][q][ii] += a * b;
+						a_out[p][q] = a;
+						b_out[p][q] = b;
+					}
+				}
+#pragma unroll
+				for (int p = 0; p < PE_ROWS; p++) {
+#pragma unroll
+					for (int q = 0; q < PE_COLS; q++) {
+#pragma unroll
+						for (int d = INTERLEAVE - 1; d > 0; d--) {
+							a_link[p][q][d] = a_link[p][q][d - 1];
+							b_link[p][q][d] = b_link[p][q][d - 1];
+						}
+						a_link[p][q][0] = __fpga_reg(a_out[p][q]);
+						b_link[p][q][0] = __fpga_reg(b_out[p][q]);
+					}
+				}
+
+				if (ii == INTERLEAVE - 1) {
+					ii = 0;
+					step++;
+				} else {
+					ii++;
+				}
+			}
+
+			// store the blocks, one row of PEs per clock cycle
+			for (int p = 0; p < PE_ROWS; ++p) {
+				for (int d = 0; d < INTERLEAVE; ++d) {
+#pragma unroll
+					for (int q = 0; q < PE_COLS; q++) {
+						C_local[bi * PE_ROWS + p][(bg * INTERLEAVE + d) * PE_COLS + q] = acc[p][q][d];
+					}
+				}
+			}
+		}
+	}
+}
+
+template<class T, int t_rowsA, int t_colsA, int t_colsB, int PE_ROWS, int PE_COLS, int INTERLEAVE = 1>
+void matrix_multiply_systolic(T A_local[t_rowsA][t_colsA], T B_local[t_colsA][t_colsB], T C_local[t_rowsA][t_colsB]) {
+	static_assert(PE_ROWS > 0 && PE_COLS > 0 && INTERLEAVE > 0, "the PE grid and INTERLEAVE must not be empty");
+	static_assert(t_rowsA % PE_ROWS == 0, "t_rowsA must be a multiple of PE_ROWS");
+	static_assert(t_colsB % (PE_COLS * INTERLEAVE) == 0, "t_colsB must be a multiple of PE_COLS * INTERLEAVE");
+#if defined(HLS_X86) && !defined(MATRIX_MULT_EMULATE_SCHEDULE)
+	matrix_multiply_x86<T, t_rowsA, t_colsA, t_colsB, 1, 1>(A_local, B_local, C_local);
+#else
+	matrix_multiply_systolic_schedule<T, t_rowsA, t_colsA, t_colsB, PE_ROWS, PE_COLS, INTERLEAVE>(A_local, B_local, C_local);
+#endif
+}
+
+// Clock cycles of matrix_multiply_systolic, one iteration of each pipelined loop per clock cycle
+template<int t_rowsA, int t_colsA, int t_colsB, int PE_ROWS, int PE_COLS, int INTERLEAVE = 1>
+constexpr long long matrix_multiply_systolic_cycles() {
+	return (long long)(t_rowsA / PE_ROWS) * (t_colsB / (PE_COLS * INTERLEAVE)) *
+	       ((long long)(t_colsA + PE_ROWS + PE_COLS - 2) * INTERLEAVE + PE_ROWS * INTERLEAVE);
+}
+
+#ifdef HLS_X86
+// Emulation model of the PE grid. Steps through the control of matrix_multiply_systolic_schedule and
+// counts for every PE the clock cycles in which it multiplies a real pair of A and B elements rather
+// than the zeros of the skew or idles while a block is stored. Prints one JSON object per PE and a summary.
+template<int t_rowsA, int t_colsA, int t_colsB, int PE_ROWS, int PE_COLS, int INTERLEAVE = 1>
+void matrix_multiply_systolic_model(FILE *f = stdout) {
+	const int STEPS = t_colsA + PE_ROWS + PE_COLS - 2;
+	const long long blocks = (long long)(t_rowsA / PE_ROWS) * (t_colsB / (PE_COLS * INTERLEAVE));
+	const long long cycles = matrix_multiply_systolic_cycles<t_rowsA, t_colsA, t_colsB, PE_ROWS, PE_COLS, INTERLEAVE>();
+	long long total_busy = 0;
+	for (int p = 0; p < PE_ROWS; p++) {
+		for (int q = 0; q < PE_COLS; q++) {
+			long long busy = 0;
+			for (int step = 0; step < STEPS; step++) {
+				const int k = step - p - q;
+				if (k >= 0 && k < t_colsA) {
+					busy += INTERLEAVE;
+				}
+			}
+			busy *= blocks;
+			total_busy += busy;
+			fprintf(f, "{\"pe_row\":%d,\"pe_col\":%d,\"busy_cycles\":%lld,\"utilization\":%.6g}\n",
+			        p, q, busy, cycles > 0 ? (double)busy / cycles : 0.0);
+		}
+	}
+	fprintf(f, "{\"pe_rows\":%d,\"pe_cols\":%d,\"interleave\":%d,\"cycles\":%lld,\"macs\":%lld,\"utilization\":%.6g}\n",
+	        PE_ROWS, PE_COLS, INTERLEAVE, cycles, (long long)t_rowsA * t_colsA * t_colsB,
+	        cycles > 0 ? (double)total_busy / ((double)cycles * PE_ROWS * PE_COLS) : 0.0);
+}
+#endif
+
+#endif //__HLS_SYSTOLIC_MATRIX_MULT_H__